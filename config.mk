@@ -9,11 +9,11 @@ PATH_EXAMPLES	  = examples
 PATH_DEBUG 		  = DebugLibC
 PATH_COLORS		  = $(PATH_DEBUG)/colors-C-C-plus-plus
 
-LINKER_FLAGS  	  =  -L. -lCIterators -lm
+LINKER_FLAGS  	  =  -L. -lCIterators -lm -lpthread
 
 INCLUDE_FLAGS = -I. -I$(PATH_INCLUDE)
 GLOBAL_CFLAGS = -std=c$(VESRION_C) $(INCLUDE_FLAGS) -masm=intel \
-				-D_ExceptionHandler -fdiagnostics-color=always -D_GNU_SOURCE $(DEBUG_LINUX)
+				-D_ExceptionHandler -fdiagnostics-color=always -D_GNU_SOURCE -pthread $(DEBUG_LINUX)
 
 ifeq ($(OS_NAME),windows)
 else
@@ -46,4 +46,4 @@ ARR_FLAGS     = -rc
 
 CFLAGS_EXAMPLES = $(CFLAGS) -save-temps -g -D DEBUG_ENABLE $(LINKER_FLAGS)
 
-OBJECTS 	  = CSortting CIterators
+OBJECTS 	  = CSortting CExternalSort CSearch CJoin CIterators
@@ -0,0 +1,92 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de generic_sort_adaptive: para cada tipo de entrada se comprueba
+// la estrategia elegida, que el resultado coincide con qsort y cuántas
+// comparaciones cuesta.
+
+static size_t comparisons = 0;
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    comparisons++;
+    return (x > y) - (x < y);
+}
+
+static int qsort_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct Case {
+    const char *name;
+    SortStrategy expected;
+    double max_per_element; // Comparaciones por elemento toleradas (0 = sin límite)
+} Case;
+
+enum { RANDOM, FEW_DISTINCT, SORTED, REVERSED, APPENDED, DESCENDING_BATCHES, CASE_COUNT };
+
+static const Case cases[CASE_COUNT] = {
+    { "aleatoria", SORT_STRATEGY_QUICKSORT, 0 },
+    { "5 claves", SORT_STRATEGY_THREE_WAY, 6 },
+    { "ordenada", SORT_STRATEGY_RUNS, 1.5 },
+    { "inversa", SORT_STRATEGY_RUNS, 1.5 },
+    { "ordenada + 1% al azar", SORT_STRATEGY_RUNS, 0 },
+    { "lotes descendentes", SORT_STRATEGY_RUNS, 0 },
+};
+
+static int case_value(int c, size_t i, size_t n, unsigned long long *seed) {
+    switch (c) {
+        case RANDOM:       return (int)(check_random(seed) % 1000000000);
+        case FEW_DISTINCT: return (int)(check_random(seed) % 5);
+        case SORTED:       return (int)i;
+        case REVERSED:     return (int)(n - i);
+        case APPENDED:     return check_random(seed) % 100 == 0 ? (int)(check_random(seed) % n) : (int)i;
+        default:           return (int)((i / 1000) * 1000 + (999 - i % 1000)); // Lotes de 1000 invertidos
+    }
+}
+
+#define N 200000
+
+int main() {
+    static int data[N], expected[N];
+    unsigned long long seed = 1234;
+
+    for (int c = 0; c < CASE_COUNT; c++) {
+        for (size_t i = 0; i < N; i++)
+            data[i] = expected[i] = case_value(c, i, N, &seed);
+        qsort(expected, N, sizeof(int), qsort_int);
+
+        Iterator it = create_generic_array_iterator(data, N, sizeof(int));
+        comparisons = 0;
+        SortStrategy strategy = generic_sort_adaptive(&it, compare_int);
+        printf("%-22s %-10s %.2f comparaciones por elemento\n", cases[c].name,
+               sort_strategy_name(strategy), (double)comparisons / N);
+
+        CHECK(strategy == cases[c].expected);
+        if (cases[c].max_per_element > 0)
+            CHECK(comparisons < cases[c].max_per_element * N);
+        size_t bad = 0;
+        for (size_t i = 0; i < N; i++)
+            bad += *(int *)iterator_at(&it, i) != expected[i];
+        CHECK(bad == 0);
+        iterator_destroy(&it);
+    }
+
+    // Por debajo de SORT_ADAPTIVE_MIN no se muestrea: siempre pdqsort
+    int small[SORT_ADAPTIVE_MIN - 1];
+    for (size_t i = 0; i < SORT_ADAPTIVE_MIN - 1; i++)
+        small[i] = (int)i;
+    Iterator it = create_generic_array_iterator(small, SORT_ADAPTIVE_MIN - 1, sizeof(int));
+    CHECK(generic_sort_adaptive(&it, compare_int) == SORT_STRATEGY_QUICKSORT);
+    iterator_destroy(&it);
+
+    // Vacío: no hay estrategia
+    it = create_generic_array_iterator(small, 0, sizeof(int));
+    CHECK(generic_sort_adaptive(&it, compare_int) == SORT_STRATEGY_NONE);
+    iterator_destroy(&it);
+
+    return check_report("adaptive_sort");
+}
@@ -0,0 +1,101 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de argsort y apply_permutation: se calcula la permutación que
+// ordena una columna y se aplica a esa columna y a otra paralela, y se
+// comprueba que apply_permutation rechaza lo que no es una permutación.
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+#define N 200000
+
+// perm debe ser una permutación que ordena keys (y, si stable, sin cruzar iguales)
+static size_t check_perm(const size_t *perm, const int *keys, size_t n, bool stable) {
+    static bool seen[N];
+    size_t bad = 0;
+    memset(seen, 0, n * sizeof(bool));
+    for (size_t i = 0; i < n; i++) {
+        bad += perm[i] >= n || seen[perm[i]];
+        if (perm[i] < n)
+            seen[perm[i]] = true;
+        if (i > 0 && perm[i] < n && perm[i - 1] < n) {
+            bad += keys[perm[i - 1]] > keys[perm[i]];
+            if (stable)
+                bad += keys[perm[i - 1]] == keys[perm[i]] && perm[i - 1] > perm[i];
+        }
+    }
+    return bad;
+}
+
+int main() {
+    static int keys[N], names[N];
+    static size_t perm[N];
+    unsigned long long seed = 31;
+
+    for (size_t i = 0; i < N; i++) {
+        keys[i] = (int)(check_random(&seed) % 1000);
+        names[i] = (int)i * 7; // Columna paralela: depende solo de la fila original
+    }
+    Iterator it = create_generic_array_iterator(keys, N, sizeof(int));
+
+    CHECK(generic_argsort(&it, compare_int, perm));
+    CHECK(check_perm(perm, keys, N, false) == 0);
+
+    CHECK(generic_stable_argsort(&it, compare_int, perm));
+    CHECK(check_perm(perm, keys, N, true) == 0);
+
+    generic_parallel_sort_set_threshold(1000);
+    CHECK(generic_parallel_argsort(&it, compare_int, perm, 4));
+    CHECK(check_perm(perm, keys, N, false) == 0);
+    generic_parallel_sort_set_threshold(0);
+
+    // argsort no toca la vista
+    CHECK(iterator_at(&it, 0) == &keys[0] && iterator_at(&it, N - 1) == &keys[N - 1]);
+    iterator_destroy(&it);
+
+    // Aplicar la misma permutación a las dos columnas: filas ordenadas por
+    // clave sin separar clave y nombre. perm queda igual que estaba.
+    static size_t perm_copy[N];
+    memcpy(perm_copy, perm, sizeof(perm));
+    CHECK(apply_permutation(keys, N, sizeof(int), perm));
+    CHECK(apply_permutation(names, N, sizeof(int), perm));
+    CHECK(memcmp(perm, perm_copy, sizeof(perm)) == 0);
+    size_t bad = 0;
+    for (size_t i = 0; i < N; i++) {
+        bad += names[i] != (int)perm[i] * 7;
+        if (i > 0)
+            bad += keys[i - 1] > keys[i];
+    }
+    CHECK(bad == 0);
+
+    // Registros más grandes que el buffer de la pila
+    typedef struct Big { int id; char data[300]; } Big;
+    static Big bigs[100];
+    size_t big_perm[100];
+    for (size_t i = 0; i < 100; i++) {
+        bigs[i].id = (int)i;
+        memset(bigs[i].data, (int)i, sizeof(bigs[i].data));
+        big_perm[i] = (i * 37) % 100;
+    }
+    CHECK(apply_permutation(bigs, 100, sizeof(Big), big_perm));
+    bad = 0;
+    for (size_t i = 0; i < 100; i++)
+        bad += bigs[i].id != (int)big_perm[i] || bigs[i].data[299] != (char)big_perm[i];
+    CHECK(bad == 0);
+
+    // Lo que no es una permutación se rechaza sin tocar los datos ni perm
+    int small[4] = { 10, 20, 30, 40 };
+    size_t repeated[4] = { 0, 2, 2, 3 };
+    size_t out_of_range[4] = { 0, 1, 2, 4 };
+    CHECK(!apply_permutation(small, 4, sizeof(int), repeated));
+    CHECK(!apply_permutation(small, 4, sizeof(int), out_of_range));
+    CHECK(small[0] == 10 && small[1] == 20 && small[2] == 30 && small[3] == 40);
+    CHECK(repeated[1] == 2 && repeated[2] == 2 && out_of_range[3] == 4);
+
+    return check_report("argsort");
+}
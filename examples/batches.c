@@ -0,0 +1,97 @@
+#include "CIterators.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo del protocolo por lotes: iterator_next_batch sobre arrays, rangos,
+// filtros y zips, y los consumidores que paran en la primera coincidencia.
+
+static bool is_odd(void *element) {
+    return *(int *)element % 2 != 0;
+}
+
+static int map_calls = 0;
+
+static void *count_map(void *element) {
+    map_calls++;
+    return element;
+}
+
+static bool at_least_10(void *element) {
+    return *(int *)element >= 10;
+}
+
+static int compare_ints(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+int main() {
+    int data[300];
+    for (int i = 0; i < 300; i++)
+        data[i] = i;
+
+    // Un array entrega lotes de hasta ITERATOR_BATCH_SIZE punteros a sus elementos
+    Iterator array_iter = create_generic_array_iterator(data, 300, sizeof(int));
+    void *batch[ITERATOR_BATCH_SIZE];
+    size_t got, seen = 0;
+    while ((got = iterator_next_batch(&array_iter, batch, ITERATOR_BATCH_SIZE)) > 0) {
+        CHECK(got <= ITERATOR_BATCH_SIZE);
+        for (size_t i = 0; i < got; i++)
+            CHECK(batch[i] == &data[seen + i]);
+        seen += got;
+    }
+    CHECK(seen == 300);
+    iterator_destroy(&array_iter);
+
+    // Los lotes de un rango reutilizan su buffer: un filtro sobre un rango
+    // no tiene elementos estables y to_array debe copiarlos uno a uno
+    Iterator odd_range = filter_iterator(create_range_iterator(0, 200, 1), is_odd);
+    CHECK(!iterator_stable_elements(&odd_range));
+    int expected = 1;
+    while ((got = iterator_next_batch(&odd_range, batch, ITERATOR_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < got; i++, expected += 2)
+            CHECK(*(int *)batch[i] == expected);
+    }
+    CHECK(expected == 201);
+    iterator_destroy(&odd_range);
+
+    // Zip de un array y un rango filtrado: cada tupla de un lote sigue siendo
+    // válida hasta la siguiente llamada aunque las columnas avancen a distinto ritmo
+    Iterator columns[2] = {
+        create_generic_array_iterator(data, 300, sizeof(int)),
+        filter_iterator(create_range_iterator(0, 1000, 1), is_odd)
+    };
+    Iterator zip = multi_zip_iterators(columns, 2);
+    size_t rows = 0;
+    while ((got = iterator_next_batch(&zip, batch, ITERATOR_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < got; i++, rows++) {
+            void **tuple = (void **)batch[i];
+            CHECK(*(int *)tuple[0] == (int)rows);
+            CHECK(*(int *)tuple[1] == 2 * (int)rows + 1);
+        }
+    }
+    CHECK(rows == 300);
+    iterator_destroy(&zip);
+
+    // find, any y all paran justo en la coincidencia: el iterador (que
+    // comparte estado con la copia pasada por valor) sigue en el elemento siguiente
+    Iterator find_iter = create_generic_array_iterator(data, 300, sizeof(int));
+    int target = 42;
+    int *found = iterator_find(find_iter, &target, compare_ints);
+    CHECK(found == &data[42]);
+    CHECK(iterator_next(&find_iter) && *(int *)iterator_deref(&find_iter) == 43);
+    iterator_destroy(&find_iter);
+
+    // ...y una fuente map_iterator solo calcula los elementos que se miran
+    Iterator mapped = map_iterator(create_generic_array_iterator(data, 300, sizeof(int)), count_map);
+    CHECK(iterator_any(mapped, at_least_10));
+    CHECK(map_calls == 11);
+    iterator_destroy(&mapped);
+
+    Iterator all_iter = create_generic_array_iterator(data, 300, sizeof(int));
+    CHECK(!iterator_all(all_iter, at_least_10));
+    CHECK(iterator_next(&all_iter) && *(int *)iterator_deref(&all_iter) == 1);
+    iterator_destroy(&all_iter);
+
+    return check_report("batches");
+}
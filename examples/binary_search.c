@@ -0,0 +1,83 @@
+#include "CSearch.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de la familia de búsqueda binaria sobre vistas ordenadas: cada
+// resultado se compara con una búsqueda lineal, tanto sobre un array ya
+// ordenado como sobre la vista que deja generic_sort (tabla de punteros).
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Referencias lineales sobre la vista
+static size_t linear_lower(Iterator *it, size_t n, int value) {
+    size_t i = 0;
+    while (i < n && *(int *)iterator_at(it, i) < value)
+        i++;
+    return i;
+}
+
+static size_t linear_upper(Iterator *it, size_t n, int value) {
+    size_t i = 0;
+    while (i < n && *(int *)iterator_at(it, i) <= value)
+        i++;
+    return i;
+}
+
+static size_t check_view(Iterator *it, size_t n, int max_value) {
+    size_t bad = 0;
+    for (int value = -2; value <= max_value + 2; value++) {
+        size_t lower = linear_lower(it, n, value), upper = linear_upper(it, n, value);
+        size_t first, last;
+
+        bad += generic_lower_bound(it, &value, compare_int) != lower;
+        bad += generic_upper_bound(it, &value, compare_int) != upper;
+        bad += generic_equal_range(it, &value, compare_int, &first, &last) != (upper > lower);
+        bad += first != lower || last != upper;
+
+        int *found = generic_binary_search(it, &value, compare_int);
+        bad += upper > lower ? found != iterator_at(it, lower) : found != NULL;
+    }
+    return bad;
+}
+
+int main() {
+    unsigned long long seed = 1618;
+    static const size_t sizes[] = { 0, 1, 2, 7, 64, 65, 1000 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        int *data = malloc((n ? n : 1) * sizeof(int));
+        int max_value = (int)(n / 2 + 1); // Muchos repetidos y huecos
+
+        // Array ya ordenado
+        for (size_t i = 0; i < n; i++)
+            data[i] = (int)(check_random(&seed) % (unsigned)(max_value + 1));
+        generic_sort_int32_array(data, n);
+        Iterator it = create_generic_array_iterator(data, n, sizeof(int));
+        CHECK(check_view(&it, n, max_value) == 0);
+        iterator_destroy(&it);
+
+        // Vista ordenada con generic_sort sobre un array desordenado
+        for (size_t i = 0; i < n; i++)
+            data[i] = (int)(check_random(&seed) % (unsigned)(max_value + 1));
+        it = create_generic_array_iterator(data, n, sizeof(int));
+        generic_sort(&it, compare_int);
+        CHECK(check_view(&it, n, max_value) == 0);
+        iterator_destroy(&it);
+
+        free(data);
+    }
+
+    // Solo se aceptan GenericArrayIterator
+    Iterator range = create_range_iterator(0, 10, 1);
+    int five = 5;
+    CHECK(generic_binary_search(&range, &five, compare_int) == NULL);
+    CHECK(generic_lower_bound(&range, &five, compare_int) == 0);
+    iterator_destroy(&range);
+
+    return check_report("binary_search");
+}
@@ -0,0 +1,78 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de la partición por bloques de pdqsort: los motores de registros
+// (intercambios especializados de 4, 8, 16 y 32 bytes y el genérico), el de
+// punteros y los tipados se ejecutan sobre patrones que llenan bloques
+// enteros de un solo lado, alternan lados o repiten la misma clave, y se
+// comparan con qsort.
+
+#define N 200000
+#define MAX_RECORD 48
+
+static int compare_key(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+enum { RANDOM, BLOCKS, ALTERNATING, EQUAL, TWO_VALUES, REVERSED, PATTERN_COUNT };
+
+static int pattern_value(int pattern, size_t i, unsigned long long *seed) {
+    switch (pattern) {
+        case RANDOM:      return (int)(check_random(seed) % 1000000);
+        case BLOCKS:      return (int)((i / 64) % 2 ? i : N - i); // Bloques de 64 de un lado y del otro
+        case ALTERNATING: return (int)(i % 2 ? i : N + i);
+        case EQUAL:       return 3;
+        case TWO_VALUES:  return (int)(check_random(seed) % 2);
+        default:          return (int)(N - i);
+    }
+}
+
+int main() {
+    static const size_t record_sizes[] = { 4, 8, 12, 16, 32, MAX_RECORD };
+    static unsigned char records[N * MAX_RECORD];
+    static int keys[N], expected[N];
+    unsigned long long seed = 21;
+
+    for (int pattern = 0; pattern < PATTERN_COUNT; pattern++) {
+        for (size_t i = 0; i < N; i++)
+            keys[i] = expected[i] = pattern_value(pattern, i, &seed);
+        qsort(expected, N, sizeof(int), compare_key);
+
+        // Registros: la clave al principio y el resto de bytes derivados de ella
+        for (size_t r = 0; r < sizeof(record_sizes) / sizeof(record_sizes[0]); r++) {
+            size_t size = record_sizes[r];
+            for (size_t i = 0; i < N; i++) {
+                unsigned char *record = records + i * size;
+                memcpy(record, &keys[i], sizeof(int));
+                memset(record + sizeof(int), keys[i] & 0xFF, size - sizeof(int));
+            }
+            generic_sort_records(records, N, size, compare_key);
+            size_t bad = 0;
+            for (size_t i = 0; i < N; i++) {
+                const unsigned char *record = records + i * size;
+                int key;
+                memcpy(&key, record, sizeof(int));
+                bad += key != expected[i] || (size > sizeof(int) && record[size - 1] != (unsigned char)(key & 0xFF));
+            }
+            CHECK(bad == 0);
+        }
+
+        // Punteros
+        Iterator it = create_generic_array_iterator(keys, N, sizeof(int));
+        generic_sort(&it, compare_key);
+        size_t bad = 0;
+        for (size_t i = 0; i < N; i++)
+            bad += *(int *)iterator_at(&it, i) != expected[i];
+        CHECK(bad == 0);
+        iterator_destroy(&it);
+
+        // Tipado
+        generic_sort_int32_array(keys, N);
+        CHECK(memcmp(keys, expected, sizeof(keys)) == 0);
+    }
+
+    return check_report("block_partition");
+}
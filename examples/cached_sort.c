@@ -0,0 +1,80 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de generic_sort_cached: la clave de cada elemento se calcula una
+// sola vez y el comparador completo solo se llama para desempatar. Se
+// comprueba el orden y se cuentan las llamadas al comparador frente a
+// generic_sort.
+
+#define N 50000
+
+static size_t string_comparisons = 0;
+
+static int compare_string(const void *a, const void *b) {
+    string_comparisons++;
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+typedef struct Measure {
+    double value;
+    int id;
+} Measure;
+
+static int compare_measure(const void *a, const void *b) {
+    double x = ((const Measure *)a)->value, y = ((const Measure *)b)->value;
+    return (x > y) - (x < y);
+}
+
+int main() {
+    static char storage[N][24];
+    static const char *strings[N], *copy[N];
+    unsigned long long seed = 123;
+
+    // La mitad comparte un prefijo largo, así que la clave de 8 bytes empata a menudo
+    for (size_t i = 0; i < N; i++) {
+        unsigned long long r = check_random(&seed);
+        snprintf(storage[i], sizeof(storage[i]), "%s%06llu", i % 2 ? "usuario/" : "", r % 1000000);
+        strings[i] = copy[i] = storage[i];
+    }
+
+    Iterator it = create_string_array_iterator(strings, N);
+    RadixKey prefix = { .key_fn = string_key_prefix, .width = 8, .type = RADIX_KEY_UNSIGNED };
+    string_comparisons = 0;
+    CHECK(generic_sort_cached(&it, &prefix, compare_string));
+    size_t cached_comparisons = string_comparisons;
+    size_t bad = 0;
+    for (size_t i = 1; i < N; i++)
+        bad += strcmp(*(char **)iterator_at(&it, i - 1), *(char **)iterator_at(&it, i)) > 0;
+    CHECK(bad == 0);
+    iterator_destroy(&it);
+
+    Iterator plain = create_string_array_iterator(copy, N);
+    string_comparisons = 0;
+    generic_sort(&plain, compare_string);
+    printf("strcmp: %zu con clave en caché, %zu con generic_sort\n", cached_comparisons, string_comparisons);
+    CHECK(cached_comparisons < string_comparisons);
+    iterator_destroy(&plain);
+
+    // Una clave double que determina el orden por sí sola: sin comparador
+    static Measure measures[N];
+    for (size_t i = 0; i < N; i++)
+        measures[i] = (Measure){ (double)(int64_t)check_random(&seed) / 1e12, (int)i };
+    Iterator mit = create_generic_array_iterator(measures, N, sizeof(Measure));
+    RadixKey value_key = { .offset = offsetof(Measure, value), .width = 8, .type = RADIX_KEY_FLOAT };
+    CHECK(generic_sort_cached(&mit, &value_key, NULL));
+    bad = 0;
+    for (size_t i = 1; i < N; i++)
+        bad += compare_measure(iterator_at(&mit, i - 1), iterator_at(&mit, i)) > 0;
+    CHECK(bad == 0);
+    iterator_destroy(&mit);
+
+    // Clave no válida
+    Iterator small = create_generic_array_iterator(measures, 10, sizeof(Measure));
+    RadixKey invalid = { .offset = 0, .width = 5, .type = RADIX_KEY_UNSIGNED };
+    CHECK(!generic_sort_cached(&small, &invalid, compare_measure));
+    iterator_destroy(&small);
+
+    return check_report("cached_sort");
+}
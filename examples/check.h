@@ -0,0 +1,40 @@
+/**
+ * @file check.h
+ * @brief Comprobaciones mínimas para los ejemplos
+ *
+ * CHECK anota cada condición que no se cumple y check_report() devuelve el
+ * código de salida del ejemplo: 0 si todo fue bien, 1 si hubo algún fallo.
+ */
+
+#ifndef EXAMPLES_CHECK_H
+#define EXAMPLES_CHECK_H
+
+#include <stdio.h>
+
+static int check_failures = 0;
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            printf("FALLO %s:%d: %s\n", __FILE__, __LINE__, #cond);             \
+            check_failures++;                                                   \
+        }                                                                       \
+    } while (0)
+
+static inline int check_report(const char *name)
+{
+    printf("%s: %s\n", name, check_failures ? "FALLOS" : "OK");
+    return check_failures != 0;
+}
+
+/** Generador pseudoaleatorio reproducible (xorshift64) para los ejemplos. */
+static inline unsigned long long check_random(unsigned long long *state)
+{
+    unsigned long long x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+#endif // EXAMPLES_CHECK_H
@@ -35,20 +35,20 @@ int main() {
     size_t arr_size = sizeof(arr) / sizeof(arr[0]);
     Iterator array_iter = create_generic_array_iterator(arr, arr_size, sizeof(int));
     printf("Generic Array Iterator: ");
-    while (array_iter.next(&array_iter)) {
-        printf("%d ", *(int *)array_iter.deref(&array_iter));
+    while (iterator_next(&array_iter)) {
+        printf("%d ", *(int *)iterator_deref(&array_iter));
     }
     printf("\n");
-    array_iter.destroy(&array_iter);
+    iterator_destroy(&array_iter);
    
     // 2. Range Iterator
     Iterator range_iter = create_range_iterator(0, 10, 2);
     printf("Range Iterator: ");
-    while (range_iter.next(&range_iter)) {
-        printf("%d ", *(int *)range_iter.deref(&range_iter));
+    while (iterator_next(&range_iter)) {
+        printf("%d ", *(int *)iterator_deref(&range_iter));
     }
     printf("\n");
-    range_iter.destroy(&range_iter);
+    iterator_destroy(&range_iter);
 
     // 3. Zip Iterator (Multiple Arrays)
     int arr1[] = {1, 2, 3};
@@ -67,12 +67,12 @@ int main() {
 
     Iterator zip_iter = multi_zip_iterators(iters, num_iters);
     printf("Multi Zip Iterator: ");
-    while (zip_iter.next(&zip_iter)) {
-        void** elements = (void**)zip_iter.deref(&zip_iter);
+    while (iterator_next(&zip_iter)) {
+        void** elements = (void**)iterator_deref(&zip_iter);
         printf("(%d, %d, %d) ", *(int*)elements[0], *(int*)elements[1], *(int*)elements[2]);
     }
     printf("\n");
-    zip_iter.destroy(&zip_iter);
+    iterator_destroy(&zip_iter);
 
     // 4. Filter Iterator
     int arr4[] = {1, 2, 3, 4, 5, 6};
@@ -80,11 +80,11 @@ int main() {
     Iterator iter4 = create_generic_array_iterator(arr4, arr_size4, sizeof(int));
     Iterator filter_iter = filter_iterator(iter4, is_even);
     printf("Filter Iterator (even numbers): ");
-    while (filter_iter.next(&filter_iter)) {
-        printf("%d ", *(int *)filter_iter.deref(&filter_iter));
+    while (iterator_next(&filter_iter)) {
+        printf("%d ", *(int *)iterator_deref(&filter_iter));
     }
     printf("\n");
-    filter_iter.destroy(&filter_iter);
+    iterator_destroy(&filter_iter);
 
     // 5. Map Iterator
     int arr5[] = {1, 2, 3, 4, 5};
@@ -92,11 +92,11 @@ int main() {
     Iterator iter5 = create_generic_array_iterator(arr5, arr_size5, sizeof(int));
     Iterator map_iter = map_iterator(iter5, square);
     printf("Map Iterator (squares): ");
-    while (map_iter.next(&map_iter)) {
-        printf("%d ", *(int *)map_iter.deref(&map_iter));
+    while (iterator_next(&map_iter)) {
+        printf("%d ", *(int *)iterator_deref(&map_iter));
     }
     printf("\n");
-    map_iter.destroy(&map_iter);
+    iterator_destroy(&map_iter);
 
      // 6. Iterator Advance
     int arr6[] = {10, 20, 30, 40, 50};
@@ -104,11 +104,11 @@ int main() {
     Iterator advance_iter = create_generic_array_iterator(arr6, arr_size6, sizeof(int));
     printf("Iterator Advance: ");
     iterator_advance(&advance_iter, 2); // Avanza 2 posiciones
-    printf("%d ", *(int *)advance_iter.deref(&advance_iter));
+    printf("%d ", *(int *)iterator_deref(&advance_iter));
     iterator_advance(&advance_iter, 1); // Avanza 1 posición
-    printf("%d ", *(int *)advance_iter.deref(&advance_iter));
+    printf("%d ", *(int *)iterator_deref(&advance_iter));
     printf("\n");
-    advance_iter.destroy(&advance_iter);
+    iterator_destroy(&advance_iter);
 
     // 7. Iterator Reset
     int arr7[] = {100, 200, 300, 400, 500};
@@ -116,10 +116,10 @@ int main() {
     Iterator reset_iter = create_generic_array_iterator(arr7, arr_size7, sizeof(int));
     iterator_advance(&reset_iter, 3); // Avanza 3 posiciones
     printf("Iterator Reset: ");
-    printf("Current value before reset: %d\n", *(int *)reset_iter.deref(&reset_iter));
+    printf("Current value before reset: %d\n", *(int *)iterator_deref(&reset_iter));
     iterator_reset(&reset_iter); // Reinicia el iterador
-    printf("Current value after reset: %d\n", *(int *)reset_iter.deref(&reset_iter));
-    reset_iter.destroy(&reset_iter);
+    printf("Current value after reset: %d\n", *(int *)iterator_deref(&reset_iter));
+    iterator_destroy(&reset_iter);
    
     // 8. String Array Iterator
     const char *strings[] = {"hello", "world", "iterators"};
@@ -127,12 +127,12 @@ int main() {
     Iterator string_iter = create_string_array_iterator(strings, string_count);
 
     printf("String Array Iterator: ");
-    while (string_iter.next(&string_iter)) {
-        const char** val = (const char**)string_iter.deref(&string_iter);
+    while (iterator_next(&string_iter)) {
+        const char** val = (const char**)iterator_deref(&string_iter);
         printf("%s ", *val);
     }
     printf("\n");
-    string_iter.destroy(&string_iter);
+    iterator_destroy(&string_iter);
    
 
      // 9. iterator_to_array
@@ -149,7 +149,7 @@ int main() {
     printf("\n");
 
     free(new_array);
-    iter8.destroy(&iter8);
+    iterator_destroy(&iter8);
    
     // 10. iterator_foreach
     int arr9[] = {12, 13, 14, 15, 16};
@@ -159,7 +159,7 @@ int main() {
     printf("iterator_foreach: ");
     iterator_foreach(iter9, print_int);
     printf("\n");
-    iter9.destroy(&iter9);
+    iterator_destroy(&iter9);
 
     // 11. iterator_find
     int arr10[] = {20, 21, 22, 23, 24};
@@ -174,7 +174,7 @@ int main() {
     } else {
         printf("Element not found\n");
     }
-    iter10.destroy(&iter10);
+    iterator_destroy(&iter10);
 
     // 12. iterator_any
     int arr11[] = {25, 26, 27, 28, 29};
@@ -188,7 +188,7 @@ int main() {
     } else {
         printf("Array has no even numbers\n");
     }
-    iter11.destroy(&iter11);
+    iterator_destroy(&iter11);
    
      // 13. iterator_all
     int arr12[] = {30, 32, 34, 36, 38}; // Todos son pares
@@ -202,7 +202,7 @@ int main() {
     } else {
         printf("Not all numbers are even\n");
     }
-    iter12.destroy(&iter12);
+    iterator_destroy(&iter12);
    
     return 0;
 }
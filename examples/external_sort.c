@@ -0,0 +1,128 @@
+#include "CExternalSort.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de ordenación externa: de fichero a fichero, de una región a un
+// iterador y fusionando varios iteradores externos, con presupuestos de
+// memoria que obligan a una o varias pasadas de fusión. Cada registro lleva
+// su id y una carga derivada de él para comprobar que no se mezcla ninguno.
+
+typedef struct Row {
+    int key;
+    int id;
+    int payload[4];
+} Row;
+
+static int compare_row(const void *a, const void *b) {
+    int x = ((const Row *)a)->key, y = ((const Row *)b)->key;
+    return (x > y) - (x < y);
+}
+
+static bool row_intact(const Row *row) {
+    return row->payload[0] == row->id * 3 && row->payload[3] == ~row->id;
+}
+
+#define N 100000
+
+// Comprueba que una secuencia de registros está ordenada y contiene cada id una vez
+typedef struct RowCheck {
+    bool seen[N];
+    int previous;
+    size_t count;
+    size_t bad;
+} RowCheck;
+
+static void row_check_start(RowCheck *check) {
+    memset(check->seen, 0, sizeof(check->seen));
+    check->previous = -1;
+    check->count = 0;
+    check->bad = 0;
+}
+
+static void row_check_add(RowCheck *check, const Row *row) {
+    check->bad += row->key < check->previous || !row_intact(row) || row->id < 0 || row->id >= N || check->seen[row->id];
+    if (row->id >= 0 && row->id < N)
+        check->seen[row->id] = true;
+    check->previous = row->key;
+    check->count++;
+}
+
+int main() {
+    static Row rows[N];
+    static RowCheck check;
+    unsigned long long seed = 2718;
+
+    for (int i = 0; i < N; i++) {
+        rows[i] = (Row){ (int)(check_random(&seed) % 50000), i, { i * 3, 0, 0, ~i } };
+    }
+
+    // 4 KiB obliga a varias pasadas de fusión; 1 MiB da pocos tramos; 64 MiB cabe entero
+    static const size_t budgets[] = { 4096, 1 << 20, 64 << 20 };
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+        size_t budget = budgets[b];
+
+        // Fichero a fichero
+        FILE *in = tmpfile(), *out = tmpfile();
+        CHECK(in && out);
+        if (!in || !out)
+            break;
+        CHECK(fwrite(rows, sizeof(Row), N, in) == N);
+        fflush(in);
+        rewind(in);
+        CHECK(generic_external_sort(fileno(in), fileno(out), sizeof(Row), compare_row, budget));
+        rewind(out);
+        row_check_start(&check);
+        Row row;
+        while (fread(&row, sizeof(Row), 1, out) == 1)
+            row_check_add(&check, &row);
+        CHECK(check.bad == 0 && check.count == N);
+        fclose(in);
+        fclose(out);
+
+        // Región a iterador, por lotes: todos los punteros de un lote deben
+        // seguir siendo válidos hasta pedir el siguiente
+        Iterator it = external_sort_region_iterator(rows, sizeof(rows), sizeof(Row), compare_row, budget);
+        CHECK(it.impl != NULL);
+        void *batch[ITERATOR_BATCH_SIZE];
+        size_t got;
+        row_check_start(&check);
+        while ((got = iterator_next_batch(&it, batch, ITERATOR_BATCH_SIZE)) > 0) {
+            for (size_t i = 0; i < got; i++)
+                row_check_add(&check, batch[i]);
+        }
+        CHECK(check.bad == 0 && check.count == N);
+        iterator_destroy(&it);
+
+        // Dos iteradores externos fusionados: el lote de la fusión mezcla
+        // registros de los dos y también deben ser válidos a la vez
+        Iterator halves[2] = {
+            external_sort_region_iterator(rows, sizeof(rows) / 2, sizeof(Row), compare_row, budget),
+            external_sort_region_iterator(rows + N / 2, sizeof(rows) / 2, sizeof(Row), compare_row, budget)
+        };
+        Iterator merged = merge_iterators(halves, 2, compare_row);
+        row_check_start(&check);
+        while ((got = iterator_next_batch(&merged, batch, ITERATOR_BATCH_SIZE)) > 0) {
+            for (size_t i = 0; i < got; i++)
+                row_check_add(&check, batch[i]);
+        }
+        CHECK(check.bad == 0 && check.count == N);
+        iterator_destroy(&merged);
+
+        // Elemento a elemento con next()/deref()
+        it = external_sort_region_iterator(rows, sizeof(rows), sizeof(Row), compare_row, budget);
+        row_check_start(&check);
+        while (iterator_next(&it))
+            row_check_add(&check, iterator_deref(&it));
+        CHECK(check.bad == 0 && check.count == N);
+        CHECK(iterator_deref(&it) == NULL);
+        iterator_destroy(&it);
+    }
+
+    // Entrada vacía
+    Iterator empty = external_sort_region_iterator(rows, 0, sizeof(Row), compare_row, 4096);
+    CHECK(empty.impl != NULL && iterator_next(&empty) == NULL);
+    iterator_destroy(&empty);
+
+    return check_report("external_sort");
+}
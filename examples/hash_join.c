@@ -0,0 +1,164 @@
+#include "CJoin.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo del hash join: inner, semi y anti join con entradas aleatorias y
+// claves repetidas, comparados con un bucle anidado; el caso en que la tabla
+// se construye con probe por ser más pequeño; claves que son el propio
+// elemento; y el rechazo de un lado build cuyos elementos no son estables.
+
+typedef struct Row {
+    int id;
+    int value;
+} Row;
+
+static const void *row_key(const void *element) {
+    return &((const Row *)element)->id;
+}
+
+static uint64_t hash_int(const void *key) {
+    return (uint64_t)(unsigned)*(const int *)key * 0x9E3779B97F4A7C15ull;
+}
+
+static bool equal_int(const void *a, const void *b) {
+    return *(const int *)a == *(const int *)b;
+}
+
+static bool keep_all(void *element) {
+    (void)element;
+    return true;
+}
+
+static const char *mode_names[] = { "inner", "semi", "anti" };
+
+// Resumen de un resultado: número de filas y suma que depende de qué filas salieron
+typedef struct Summary {
+    size_t rows;
+    long long checksum;
+} Summary;
+
+static Summary nested_loop(const Row *build, size_t nb, const Row *probe, size_t np, JoinMode mode) {
+    Summary s = { 0, 0 };
+    for (size_t j = 0; j < np; j++) {
+        size_t matches = 0;
+        for (size_t i = 0; i < nb; i++) {
+            if (build[i].id != probe[j].id)
+                continue;
+            matches++;
+            if (mode == JOIN_INNER) {
+                s.rows++;
+                s.checksum += (long long)build[i].value * 1000 + probe[j].value;
+            }
+        }
+        if ((mode == JOIN_LEFT_SEMI && matches > 0) || (mode == JOIN_ANTI && matches == 0)) {
+            s.rows++;
+            s.checksum += probe[j].value;
+        }
+    }
+    return s;
+}
+
+// Recorre el join; cuenta en *bad las tuplas que no casan o no apuntan a build y probe
+static Summary run_join(Iterator *join, JoinMode mode, const Row *build, size_t nb, const Row *probe,
+                        size_t np, bool batches, size_t *bad) {
+    Summary s = { 0, 0 };
+    void *batch[100];
+    for (;;) {
+        size_t got;
+        if (batches) {
+            got = iterator_next_batch(join, batch, 100);
+        } else {
+            got = iterator_next(join) ? 1 : 0;
+            batch[0] = iterator_deref(join);
+        }
+        if (got == 0)
+            break;
+        for (size_t i = 0; i < got; i++, s.rows++) {
+            if (mode == JOIN_INNER) {
+                void **tuple = batch[i];
+                const Row *b = tuple[0], *p = tuple[1];
+                *bad += b < build || b >= build + nb || p < probe || p >= probe + np || b->id != p->id;
+                s.checksum += (long long)b->value * 1000 + p->value;
+            } else {
+                const Row *p = batch[i];
+                *bad += p < probe || p >= probe + np;
+                s.checksum += p->value;
+            }
+        }
+    }
+    *bad += iterator_deref(join) != NULL;
+    return s;
+}
+
+#define MAX_ROWS 300
+
+int main() {
+    static Row build[MAX_ROWS], probe[MAX_ROWS];
+    unsigned long long seed = 25;
+    size_t bad = 0, mismatched[3] = { 0 };
+
+    // Rondas aleatorias: probe como array o como filtro, con next o por lotes.
+    // Con probe de array más pequeño, la tabla de JOIN_INNER se construye con probe.
+    for (int round = 0; round < 600; round++) {
+        size_t nb = check_random(&seed) % MAX_ROWS, np = check_random(&seed) % MAX_ROWS;
+        int range = 1 + (int)(check_random(&seed) % 200);
+        for (size_t i = 0; i < nb; i++)
+            build[i] = (Row){ (int)(check_random(&seed) % range), (int)i };
+        for (size_t i = 0; i < np; i++)
+            probe[i] = (Row){ (int)(check_random(&seed) % range), (int)i };
+
+        JoinMode mode = (JoinMode)(round % 3);
+        bool stream = round / 3 % 2, batches = round / 6 % 2;
+        Iterator ip = create_generic_array_iterator(probe, np, sizeof(Row));
+        if (stream)
+            ip = filter_iterator(ip, keep_all);
+        Iterator join = hash_join_iterator_mode(create_generic_array_iterator(build, nb, sizeof(Row)), ip, mode,
+                                                row_key, hash_int, equal_int);
+        CHECK(join.impl != NULL);
+        Summary got = run_join(&join, mode, build, nb, probe, np, batches, &bad);
+        Summary expected = nested_loop(build, nb, probe, np, mode);
+        mismatched[mode] += got.rows != expected.rows || got.checksum != expected.checksum;
+        iterator_destroy(&join);
+    }
+    for (int mode = JOIN_INNER; mode <= JOIN_ANTI; mode++) {
+        if (mismatched[mode])
+            printf("%s: %zu rondas distintas del bucle anidado\n", mode_names[mode], mismatched[mode]);
+        CHECK(mismatched[mode] == 0);
+    }
+    CHECK(bad == 0);
+
+    // build grande y probe pequeño: la tupla sigue siendo {build, probe}
+    for (int i = 0; i < MAX_ROWS; i++)
+        build[i] = (Row){ i % 50, i };
+    for (int i = 0; i < 5; i++)
+        probe[i] = (Row){ i * 20, i };
+    Iterator join = hash_join_iterator(create_generic_array_iterator(build, MAX_ROWS, sizeof(Row)),
+                                       create_generic_array_iterator(probe, 5, sizeof(Row)), row_key, hash_int,
+                                       equal_int);
+    Summary got = run_join(&join, JOIN_INNER, build, MAX_ROWS, probe, 5, true, &bad);
+    Summary expected = nested_loop(build, MAX_ROWS, probe, 5, JOIN_INNER);
+    CHECK(got.rows == 18 && got.rows == expected.rows && got.checksum == expected.checksum);
+    CHECK(bad == 0);
+    iterator_destroy(&join);
+
+    // Sin key_fn el propio elemento es la clave; probe puede ser un rango
+    int keys[] = { 3, 5, 5, 8 };
+    join = hash_join_iterator_mode(create_generic_array_iterator(keys, 4, sizeof(int)),
+                                   create_range_iterator(0, 10, 1), JOIN_LEFT_SEMI, NULL, hash_int, equal_int);
+    int semi[4], count = 0;
+    while (iterator_next(&join))
+        semi[count < 4 ? count++ : 3] = *(int *)iterator_deref(&join);
+    CHECK(count == 3 && semi[0] == 3 && semi[1] == 5 && semi[2] == 8);
+    iterator_destroy(&join);
+
+    // Un build sin elementos estables (un rango) se rechaza y las entradas siguen siendo del llamador
+    Iterator range = create_range_iterator(0, 10, 1);
+    Iterator array = create_generic_array_iterator(keys, 4, sizeof(int));
+    join = hash_join_iterator(range, array, NULL, hash_int, equal_int);
+    CHECK(join.impl == NULL);
+    iterator_destroy(&range);
+    iterator_destroy(&array);
+
+    return check_report("hash_join");
+}
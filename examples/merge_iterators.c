@@ -0,0 +1,102 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de merge_iterators: fusiona arrays ordenados, rangos y filtros
+// sobre rangos (cuyos elementos no son estables) con next y por lotes, y
+// compara el resultado con la concatenación ordenada por qsort.
+
+#define SOURCES 6
+#define MAX_LEN 3000
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static bool is_multiple_of_3(void *element) {
+    return *(int *)element % 3 == 0;
+}
+
+static int arrays[SOURCES][MAX_LEN];
+static size_t lengths[SOURCES];
+static int expected[SOURCES * MAX_LEN + 2000];
+
+// Fuentes: 0-3 arrays ordenados con repetidos (el 3 vacío), 4 un rango y 5 un filtro sobre un rango
+static size_t make_sources(Iterator *sources, size_t k) {
+    size_t total = 0;
+    for (size_t s = 0; s < k; s++) {
+        if (s == 4) {
+            sources[s] = create_range_iterator(0, 1000, 1);
+            for (int v = 0; v < 1000; v++)
+                expected[total++] = v;
+        } else if (s == 5) {
+            sources[s] = filter_iterator(create_range_iterator(0, 3000, 1), is_multiple_of_3);
+            for (int v = 0; v < 3000; v += 3)
+                expected[total++] = v;
+        } else {
+            sources[s] = create_generic_array_iterator(arrays[s], lengths[s], sizeof(int));
+            memcpy(expected + total, arrays[s], lengths[s] * sizeof(int));
+            total += lengths[s];
+        }
+    }
+    qsort(expected, total, sizeof(int), compare_int);
+    return total;
+}
+
+int main() {
+    unsigned long long seed = 23;
+    for (size_t s = 0; s < 4; s++) {
+        lengths[s] = s == 3 ? 0 : MAX_LEN - 1000 * s;
+        for (size_t i = 0; i < lengths[s]; i++)
+            arrays[s][i] = (int)(check_random(&seed) % 2000);
+        qsort(arrays[s], lengths[s], sizeof(int), compare_int);
+    }
+
+    Iterator sources[SOURCES];
+    for (size_t k = 0; k <= SOURCES; k++) {
+        // Con next
+        size_t total = make_sources(sources, k);
+        Iterator merged = merge_iterators(sources, k, compare_int);
+        size_t seen = 0, bad = 0;
+        while (iterator_next(&merged)) {
+            bad += seen >= total || *(int *)iterator_deref(&merged) != expected[seen];
+            seen++;
+        }
+        CHECK(bad == 0 && seen == total);
+        CHECK(iterator_deref(&merged) == NULL);
+        iterator_destroy(&merged);
+
+        // Por lotes: todo el lote sigue siendo válido aunque haya rangos y filtros
+        make_sources(sources, k);
+        merged = merge_iterators(sources, k, compare_int);
+        CHECK(iterator_stable_elements(&merged) == (k <= 4));
+        void *batch[ITERATOR_BATCH_SIZE];
+        size_t got;
+        seen = bad = 0;
+        while ((got = iterator_next_batch(&merged, batch, ITERATOR_BATCH_SIZE)) > 0) {
+            for (size_t i = 0; i < got; i++, seen++)
+                bad += seen >= total || *(int *)batch[i] != expected[seen];
+        }
+        CHECK(bad == 0 && seen == total);
+        CHECK(iterator_deref(&merged) == NULL);
+        iterator_destroy(&merged);
+    }
+
+    // Claves iguales: sale antes el elemento de la fuente de menor índice
+    int left[] = { 1, 2, 2, 5 }, right[] = { 2, 5, 5 };
+    Iterator pair[2] = {
+        create_generic_array_iterator(left, 4, sizeof(int)),
+        create_generic_array_iterator(right, 3, sizeof(int))
+    };
+    Iterator merged = merge_iterators(pair, 2, compare_int);
+    int *order[] = { &left[0], &left[1], &left[2], &right[0], &left[3], &right[1], &right[2] };
+    size_t bad = 0, seen = 0;
+    while (iterator_next(&merged))
+        bad += seen >= 7 || iterator_deref(&merged) != order[seen++];
+    CHECK(bad == 0 && seen == 7);
+    iterator_destroy(&merged);
+
+    return check_report("merge_iterators");
+}
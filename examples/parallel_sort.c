@@ -0,0 +1,72 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de ordenación paralela con distintos números de hilos, por encima
+// y por debajo del umbral, comparada con el resultado de qsort.
+
+typedef struct Entry {
+    int key;
+    int id;
+} Entry;
+
+static int compare_entry(const void *a, const void *b) {
+    int x = ((const Entry *)a)->key, y = ((const Entry *)b)->key;
+    return (x > y) - (x < y);
+}
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+#define N 300000
+
+int main() {
+    static int data[N], expected[N];
+    static Entry entries[N];
+    static bool seen[N];
+    unsigned long long seed = 5;
+
+    for (size_t i = 0; i < N; i++)
+        data[i] = expected[i] = (int)(check_random(&seed) % 1000000);
+    qsort(expected, N, sizeof(int), compare_int);
+
+    // Umbral bajo para que también los tamaños pequeños pasen por los hilos
+    generic_parallel_sort_set_threshold(1000);
+    static const size_t thread_counts[] = { 0, 1, 2, 3, 8 };
+    static const size_t sizes[] = { 0, 10, 999, 1000, 4097, N };
+
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            size_t n = sizes[s];
+            static int prefix[N];
+            memcpy(prefix, data, n * sizeof(int));
+            qsort(prefix, n, sizeof(int), compare_int);
+
+            Iterator it = create_generic_array_iterator(data, n, sizeof(int));
+            generic_parallel_sort(&it, compare_int, thread_counts[t]);
+            size_t bad = 0;
+            for (size_t i = 0; i < n; i++)
+                bad += *(int *)iterator_at(&it, i) != prefix[i];
+            CHECK(bad == 0);
+            iterator_destroy(&it);
+        }
+
+        // Registros: quedan ordenados y cada uno conserva su id
+        for (size_t i = 0; i < N; i++)
+            entries[i] = (Entry){ data[i], (int)i };
+        generic_parallel_sort_records(entries, N, sizeof(Entry), compare_entry, thread_counts[t]);
+        memset(seen, 0, sizeof(seen));
+        size_t bad = 0;
+        for (size_t i = 0; i < N; i++) {
+            bad += entries[i].key != expected[i] || entries[i].key != data[entries[i].id] || seen[entries[i].id];
+            seen[entries[i].id] = true;
+        }
+        CHECK(bad == 0);
+    }
+    generic_parallel_sort_set_threshold(0);
+
+    return check_report("parallel_sort");
+}
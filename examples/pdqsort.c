@@ -0,0 +1,87 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de generic_sort (pattern-defeating quicksort) sobre la vista de un
+// array: el resultado se compara con qsort para varios patrones de entrada y
+// se cuentan las comparaciones en las entradas que deben ser casi lineales.
+
+static size_t comparisons = 0;
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    comparisons++;
+    return (x > y) - (x < y);
+}
+
+static int qsort_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+enum { RANDOM, SORTED, REVERSED, EQUAL, FEW_DISTINCT, ORGAN_PIPE, SAWTOOTH, PATTERN_COUNT };
+
+static const char *pattern_names[PATTERN_COUNT] = {
+    "random", "sorted", "reversed", "equal", "few distinct", "organ pipe", "sawtooth"
+};
+
+static void fill(int *data, size_t n, int pattern, unsigned long long *seed) {
+    for (size_t i = 0; i < n; i++) {
+        switch (pattern) {
+            case RANDOM:       data[i] = (int)check_random(seed); break;
+            case SORTED:       data[i] = (int)i; break;
+            case REVERSED:     data[i] = (int)(n - i); break;
+            case EQUAL:        data[i] = 7; break;
+            case FEW_DISTINCT: data[i] = (int)(check_random(seed) % 4); break;
+            case ORGAN_PIPE:   data[i] = (int)(i < n / 2 ? i : n - i); break;
+            default:           data[i] = (int)(i % 97); break;
+        }
+    }
+}
+
+int main() {
+    static const size_t sizes[] = { 0, 1, 2, 3, 10, 31, 100, 1000, 5000, 100000 };
+    unsigned long long seed = 42;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        int *data = malloc((n ? n : 1) * sizeof(int));
+        int *expected = malloc((n ? n : 1) * sizeof(int));
+
+        for (int pattern = 0; pattern < PATTERN_COUNT; pattern++) {
+            fill(data, n, pattern, &seed);
+            memcpy(expected, data, n * sizeof(int));
+            qsort(expected, n, sizeof(int), qsort_int);
+
+            // generic_sort ordena la tabla de punteros de la vista, no el array
+            Iterator it = create_generic_array_iterator(data, n, sizeof(int));
+            comparisons = 0;
+            generic_sort(&it, compare_int);
+
+            size_t bad = 0;
+            for (size_t i = 0; i < n; i++)
+                bad += *(int *)iterator_at(&it, i) != expected[i];
+            CHECK(bad == 0);
+
+            if (n == 100000 && (pattern == SORTED || pattern == REVERSED || pattern == EQUAL))
+                CHECK(comparisons < 3 * n);
+            if (n == 100000)
+                printf("%-12s n=%zu: %zu comparaciones\n", pattern_names[pattern], n, comparisons);
+            iterator_destroy(&it);
+        }
+        free(data);
+        free(expected);
+    }
+
+    // Los punteros siguen apuntando al array del usuario
+    int small[] = { 5, 3, 9, 1, 7 };
+    Iterator it = create_generic_array_iterator(small, 5, sizeof(int));
+    generic_sort(&it, compare_int);
+    CHECK(iterator_at(&it, 0) == &small[3]);
+    CHECK(iterator_at(&it, 4) == &small[2]);
+    CHECK(small[0] == 5);
+    iterator_destroy(&it);
+
+    return check_report("pdqsort");
+}
@@ -0,0 +1,94 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de radix sort con claves enteras con y sin signo, flotantes y
+// extraídas con una función, tanto en la vista de un iterador (LSD o MSD
+// según el tamaño) como en un buffer de registros.
+
+typedef struct Sample {
+    int16_t id;
+    float score;    // Clave flotante en offset 4
+    int64_t stamp;  // Clave con signo en offset 8
+} Sample;
+
+static uint64_t sample_id_key(const void *element) {
+    return (uint64_t)(uint16_t)((const Sample *)element)->id;
+}
+
+static bool sorted_by_score(Sample *samples, size_t n) {
+    for (size_t i = 1; i < n; i++)
+        if (samples[i - 1].score > samples[i].score)
+            return false;
+    return true;
+}
+
+int main() {
+    unsigned long long seed = 99;
+    static const size_t sizes[] = { 0, 1, 50, 300, 5000, 200000 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        Sample *samples = malloc((n ? n : 1) * sizeof(Sample));
+        for (size_t i = 0; i < n; i++) {
+            samples[i].id = (int16_t)i;
+            samples[i].score = (float)((int64_t)(check_random(&seed) % 20001) - 10000) / 7.0f;
+            samples[i].stamp = (int64_t)check_random(&seed);
+        }
+
+        // Enteros de 64 bits con signo, en la vista: el array no se mueve
+        RadixKey stamp_key = { .offset = offsetof(Sample, stamp), .width = 8, .type = RADIX_KEY_SIGNED };
+        Iterator it = create_generic_array_iterator(samples, n, sizeof(Sample));
+        CHECK(generic_radix_sort(&it, &stamp_key));
+        size_t bad = 0;
+        for (size_t i = 1; i < n; i++)
+            bad += ((Sample *)iterator_at(&it, i - 1))->stamp > ((Sample *)iterator_at(&it, i))->stamp;
+        CHECK(bad == 0);
+        for (size_t i = 0; i < n; i++)
+            bad += samples[i].id != (int16_t)i;
+        CHECK(bad == 0);
+        iterator_destroy(&it);
+
+        // Flotantes, moviendo los registros
+        RadixKey score_key = { .offset = offsetof(Sample, score), .width = 4, .type = RADIX_KEY_FLOAT };
+        CHECK(generic_radix_sort_records(samples, n, sizeof(Sample), &score_key));
+        CHECK(sorted_by_score(samples, n));
+
+        // Clave extraída con una función: el id original sin signo
+        RadixKey id_key = { .key_fn = sample_id_key, .width = 2, .type = RADIX_KEY_UNSIGNED };
+        CHECK(generic_radix_sort_records(samples, n, sizeof(Sample), &id_key));
+        bad = 0;
+        for (size_t i = 1; i < n; i++)
+            bad += (uint16_t)samples[i - 1].id > (uint16_t)samples[i].id;
+        CHECK(bad == 0);
+        free(samples);
+    }
+
+    // LSD es estable: con claves repetidas se conserva el orden de entrada
+    enum { M = 100000 };
+    static uint32_t pairs[M][2];
+    for (uint32_t i = 0; i < M; i++) {
+        pairs[i][0] = (uint32_t)(check_random(&seed) % 100);
+        pairs[i][1] = i;
+    }
+    RadixKey pair_key = { .offset = 0, .width = 4, .type = RADIX_KEY_UNSIGNED };
+    Iterator pit = create_generic_array_iterator(pairs, M, sizeof(pairs[0]));
+    CHECK(generic_radix_sort(&pit, &pair_key));
+    size_t unstable = 0;
+    for (size_t i = 1; i < M; i++) {
+        const uint32_t *a = iterator_at(&pit, i - 1), *b = iterator_at(&pit, i);
+        unstable += a[0] > b[0] || (a[0] == b[0] && a[1] > b[1]);
+    }
+    CHECK(unstable == 0);
+    iterator_destroy(&pit);
+
+    // Una clave mal descrita se rechaza sin tocar nada
+    int values[] = { 3, 1, 2 };
+    RadixKey bad_key = { .offset = 0, .width = 3, .type = RADIX_KEY_SIGNED };
+    CHECK(!radix_key_valid(&bad_key));
+    CHECK(!generic_radix_sort_records(values, 3, sizeof(int), &bad_key));
+    CHECK(values[0] == 3 && values[1] == 1 && values[2] == 2);
+
+    return check_report("radix_sort");
+}
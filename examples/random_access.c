@@ -0,0 +1,90 @@
+#include "CIterators.h"
+#include "check.h"
+
+// Ejemplo de acceso aleatorio en O(1): iterator_advance, iterator_distance,
+// iterator_at e iterator_size sobre arrays, arrays con stride y rangos,
+// comparados con lo que da recorrerlos con next().
+
+static bool is_even(void *element) {
+    return *(int *)element % 2 == 0;
+}
+
+typedef struct Point {
+    int x, y;
+} Point;
+
+int main() {
+    int data[100];
+    for (int i = 0; i < 100; i++)
+        data[i] = i * 3;
+
+    Iterator array_iter = create_generic_array_iterator(data, 100, sizeof(int));
+    CHECK(iterator_is_random_access(&array_iter));
+    CHECK(iterator_size(&array_iter) == 100);
+    for (size_t i = 0; i < 100; i++)
+        CHECK(iterator_at(&array_iter, i) == &data[i]);
+    CHECK(iterator_at(&array_iter, 100) == NULL);
+
+    // advance(n) deja el iterador donde lo dejarían n llamadas a next()
+    Iterator walker = create_generic_array_iterator(data, 100, sizeof(int));
+    for (int i = 0; i < 37; i++)
+        iterator_next(&walker);
+    CHECK(iterator_advance(&array_iter, 37));
+    CHECK(iterator_deref(&array_iter) == iterator_deref(&walker));
+    CHECK(*(int *)iterator_deref(&array_iter) == 36 * 3);
+
+    Iterator start = create_generic_array_iterator(data, 100, sizeof(int));
+    CHECK(iterator_distance(&start, &array_iter) == 37);
+    CHECK(iterator_distance(&array_iter, &start) == -37);
+
+    // Pasarse del final agota el iterador
+    CHECK(!iterator_advance(&array_iter, 1000));
+    CHECK(iterator_deref(&array_iter) == NULL);
+    CHECK(iterator_next(&array_iter) == NULL);
+    iterator_destroy(&array_iter);
+    iterator_destroy(&walker);
+    iterator_destroy(&start);
+
+    // Columna y de un array de estructuras, sin copiarla
+    Point points[50];
+    for (int i = 0; i < 50; i++)
+        points[i] = (Point){ i, -i };
+    Iterator ys = create_strided_array_iterator(&points[0].y, 50, sizeof(int), sizeof(Point));
+    CHECK(iterator_size(&ys) == 50);
+    CHECK(iterator_at(&ys, 20) == &points[20].y);
+    CHECK(iterator_advance(&ys, 10) && *(int *)iterator_deref(&ys) == -9);
+    iterator_destroy(&ys);
+
+    // Rangos con paso positivo y negativo
+    Iterator up = create_range_iterator(5, 50, 7); // 5 12 19 26 33 40 47
+    CHECK(iterator_size(&up) == 7);
+    CHECK(*(int *)iterator_at(&up, 6) == 47);
+    CHECK(iterator_at(&up, 7) == NULL);
+    CHECK(iterator_advance(&up, 3) && *(int *)iterator_deref(&up) == 19);
+    CHECK(!iterator_advance(&up, 10));
+    iterator_destroy(&up);
+
+    Iterator down = create_range_iterator(10, 0, -3); // 10 7 4 1
+    CHECK(iterator_size(&down) == 4);
+    CHECK(*(int *)iterator_at(&down, 3) == 1);
+    Iterator down_start = create_range_iterator(10, 0, -3);
+    iterator_next(&down_start);
+    CHECK(iterator_advance(&down, 4) && *(int *)iterator_deref(&down) == 1);
+    CHECK(iterator_distance(&down_start, &down) == 3);
+    iterator_destroy(&down);
+    iterator_destroy(&down_start);
+
+    // Un filtro no tiene acceso aleatorio: advance recurre a next()
+    Iterator filtered = filter_iterator(create_generic_array_iterator(data, 100, sizeof(int)), is_even);
+    CHECK(!iterator_is_random_access(&filtered));
+    CHECK(iterator_size(&filtered) == 0 && iterator_at(&filtered, 0) == NULL);
+    CHECK(iterator_advance(&filtered, 5) && *(int *)iterator_deref(&filtered) == 24);
+    iterator_destroy(&filtered);
+
+    Iterator empty = create_range_iterator(0, 0, 1);
+    CHECK(iterator_size(&empty) == 0);
+    CHECK(iterator_next(&empty) == NULL);
+    iterator_destroy(&empty);
+
+    return check_report("random_access");
+}
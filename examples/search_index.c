@@ -0,0 +1,86 @@
+#include "CSearch.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de los índices de búsqueda: Eytzinger (con comparador) y B-tree
+// estático (con clave entera), construidos sobre un array ordenado de
+// registros y sobre la vista de un iterador. Cada consulta se compara con
+// generic_lower_bound sobre los mismos datos.
+
+typedef struct Item {
+    int64_t key;
+    int id;
+} Item;
+
+static int compare_item(const void *a, const void *b) {
+    int64_t x = ((const Item *)a)->key, y = ((const Item *)b)->key;
+    return (x > y) - (x < y);
+}
+
+static const RadixKey item_key = { .offset = offsetof(Item, key), .width = 8, .type = RADIX_KEY_SIGNED };
+
+// Comprueba un índice contra la búsqueda binaria sobre `view`
+static size_t check_index(const SearchIndex *index, Iterator *view, size_t n, int64_t spread,
+                          bool keyed, unsigned long long *seed) {
+    size_t bad = 0;
+    for (int q = 0; q < 2000; q++) {
+        Item probe = { (int64_t)(check_random(seed) % (unsigned long long)(2 * spread + 10)) - spread - 5, -1 };
+        size_t lower = generic_lower_bound(view, &probe, compare_item);
+        Item *expected_lower = lower < n ? iterator_at(view, lower) : NULL;
+        Item *expected_find = expected_lower && expected_lower->key == probe.key ? expected_lower : NULL;
+
+        // Con repetidos, lower_bound y find deben dar el primero de ellos
+        bad += search_index_lower_bound(index, &probe) != expected_lower;
+        bad += search_index_find(index, &probe) != expected_find;
+        if (keyed)
+            bad += search_index_find_key(index, (uint64_t)probe.key) != expected_find;
+    }
+    return bad;
+}
+
+int main() {
+    unsigned long long seed = 8;
+    static const size_t sizes[] = { 0, 1, 7, 8, 9, 63, 64, 65, 1000, 100000 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        int64_t spread = (int64_t)n + 1;
+        Item *items = malloc((n ? n : 1) * sizeof(Item));
+        for (size_t i = 0; i < n; i++)
+            items[i] = (Item){ (int64_t)(check_random(&seed) % (unsigned long long)(2 * spread)) - spread, (int)i };
+        generic_sort_records(items, n, sizeof(Item), compare_item);
+        Iterator view = create_generic_array_iterator(items, n, sizeof(Item));
+
+        SearchIndex eytzinger = search_index_build_records(items, n, sizeof(Item), compare_item);
+        CHECK(eytzinger.origin != NULL);
+        CHECK(check_index(&eytzinger, &view, n, spread, false, &seed) == 0);
+        search_index_destroy(&eytzinger);
+
+        SearchIndex eytzinger_view = search_index_build(&view, compare_item);
+        CHECK(check_index(&eytzinger_view, &view, n, spread, false, &seed) == 0);
+        search_index_destroy(&eytzinger_view);
+
+        SearchIndex btree = search_index_build_keyed_records(items, n, sizeof(Item), &item_key);
+        CHECK(btree.origin != NULL);
+        CHECK(check_index(&btree, &view, n, spread, true, &seed) == 0);
+        search_index_destroy(&btree);
+
+        SearchIndex btree_view = search_index_build_keyed(&view, &item_key);
+        CHECK(check_index(&btree_view, &view, n, spread, true, &seed) == 0);
+        search_index_destroy(&btree_view);
+        CHECK(btree_view.origin == NULL);
+
+        iterator_destroy(&view);
+        free(items);
+    }
+
+    // Un índice por comparador no responde a búsquedas por clave
+    Item one = { 5, 0 };
+    SearchIndex index = search_index_build_records(&one, 1, sizeof(Item), compare_item);
+    CHECK(search_index_find(&index, &one) == &one);
+    CHECK(search_index_find_key(&index, 5) == NULL);
+    search_index_destroy(&index);
+
+    return check_report("search_index");
+}
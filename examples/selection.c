@@ -0,0 +1,75 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de selección: generic_nth_element, generic_partial_sort y
+// generic_top_k comparados con el array ordenado completo.
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+#define N 50000
+
+int main() {
+    static int data[N], sorted[N];
+    static void *top[N];
+    unsigned long long seed = 77;
+
+    for (size_t i = 0; i < N; i++)
+        data[i] = sorted[i] = (int)(check_random(&seed) % 10000); // Con repetidos
+    qsort(sorted, N, sizeof(int), compare_int);
+
+    static const size_t positions[] = { 0, 1, 17, N / 2, N - 2, N - 1 };
+    for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+        size_t nth = positions[p];
+
+        // nth_element: el elemento correcto en nth, menores o iguales delante
+        Iterator it = create_generic_array_iterator(data, N, sizeof(int));
+        generic_nth_element(&it, nth, compare_int);
+        int pivot = *(int *)iterator_at(&it, nth);
+        CHECK(pivot == sorted[nth]);
+        size_t bad = 0;
+        for (size_t i = 0; i < N; i++)
+            bad += i < nth ? *(int *)iterator_at(&it, i) > pivot : *(int *)iterator_at(&it, i) < pivot;
+        CHECK(bad == 0);
+        iterator_destroy(&it);
+
+        // partial_sort: los k primeros son los k menores, en orden
+        size_t k = nth + 1;
+        it = create_generic_array_iterator(data, N, sizeof(int));
+        generic_partial_sort(&it, k, compare_int);
+        bad = 0;
+        for (size_t i = 0; i < k; i++)
+            bad += *(int *)iterator_at(&it, i) != sorted[i];
+        for (size_t i = k; i < N; i++)
+            bad += *(int *)iterator_at(&it, i) < sorted[k - 1];
+        CHECK(bad == 0);
+        iterator_destroy(&it);
+
+        // top_k: no toca la vista y escribe los k menores ordenados
+        it = create_generic_array_iterator(data, N, sizeof(int));
+        CHECK(generic_top_k(&it, k, compare_int, top) == k);
+        bad = 0;
+        for (size_t i = 0; i < k; i++)
+            bad += *(int *)top[i] != sorted[i];
+        for (size_t i = 0; i < N; i++)
+            bad += iterator_at(&it, i) != &data[i];
+        CHECK(bad == 0);
+        iterator_destroy(&it);
+    }
+
+    // Casos límite
+    int small[] = { 4, 2, 3 };
+    Iterator it = create_generic_array_iterator(small, 3, sizeof(int));
+    CHECK(generic_top_k(&it, 10, compare_int, top) == 3);
+    CHECK(*(int *)top[0] == 2 && *(int *)top[2] == 4);
+    CHECK(generic_top_k(&it, 0, compare_int, top) == 0);
+    generic_nth_element(&it, 3, compare_int); // Fuera de rango: no hace nada
+    CHECK(iterator_at(&it, 0) == &small[0]);
+    iterator_destroy(&it);
+
+    return check_report("selection");
+}
@@ -0,0 +1,153 @@
+#include "CSearch.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de las operaciones de conjuntos sobre entradas ordenadas con
+// repetidos (semántica de multiconjunto): unión, intersección, diferencia y
+// diferencia simétrica, con next y por lotes, sobre arrays, filtros y
+// rangos, comparadas con una fusión lineal de referencia.
+
+#define MAX_LEN 5000
+
+static size_t comparisons = 0;
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    comparisons++;
+    return (x > y) - (x < y);
+}
+
+static bool keep_all(void *element) {
+    (void)element;
+    return true;
+}
+
+static bool is_even(void *element) {
+    return *(int *)element % 2 == 0;
+}
+
+// Referencia: cada elemento de A se empareja como mucho con uno igual de B
+static size_t reference(const int *a, size_t na, const int *b, size_t nb, SetOperation op, int *out) {
+    size_t n = 0, i = 0, j = 0;
+    while (i < na || j < nb) {
+        if (j >= nb || (i < na && a[i] < b[j])) {
+            if (op != SET_INTERSECTION)
+                out[n++] = a[i];
+            i++;
+        } else if (i >= na || b[j] < a[i]) {
+            if (op == SET_UNION || op == SET_SYMMETRIC_DIFFERENCE)
+                out[n++] = b[j];
+            j++;
+        } else {
+            if (op == SET_UNION || op == SET_INTERSECTION)
+                out[n++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    return n;
+}
+
+// Recorre el iterador con next o por lotes y cuenta las diferencias con expected
+static size_t count_mismatches(Iterator *it, const int *expected, size_t n, bool batches) {
+    size_t seen = 0, bad = 0;
+    if (batches) {
+        void *batch[37]; // Tamaño que no divide a ITERATOR_BATCH_SIZE
+        size_t got;
+        while ((got = iterator_next_batch(it, batch, 37)) > 0) {
+            for (size_t i = 0; i < got; i++, seen++)
+                bad += seen >= n || *(int *)batch[i] != expected[seen];
+        }
+    } else {
+        while (iterator_next(it)) {
+            bad += seen >= n || *(int *)iterator_deref(it) != expected[seen];
+            seen++;
+        }
+    }
+    return bad + (seen != n) + (iterator_deref(it) != NULL);
+}
+
+int main() {
+    static int a[MAX_LEN], b[MAX_LEN], expected[2 * MAX_LEN];
+    unsigned long long seed = 24;
+    size_t bad = 0;
+
+    // Tamaños muy desiguales para ejercitar el galope y rangos de claves
+    // pequeños para que haya muchos repetidos
+    for (int round = 0; round < 400; round++) {
+        size_t na = check_random(&seed) % 200;
+        size_t nb = check_random(&seed) % (round % 7 == 0 ? MAX_LEN : 200);
+        int range = 1 + (int)(check_random(&seed) % (round % 2 ? 50 : 100000));
+        for (size_t i = 0; i < na; i++)
+            a[i] = (int)(check_random(&seed) % range);
+        for (size_t i = 0; i < nb; i++)
+            b[i] = (int)(check_random(&seed) % range);
+        generic_sort_int32_array(a, na);
+        generic_sort_int32_array(b, nb);
+
+        SetOperation op = (SetOperation)(round % 4);
+        size_t n = reference(a, na, b, nb, op, expected);
+        Iterator ia = create_generic_array_iterator(a, na, sizeof(int));
+        Iterator ib = create_generic_array_iterator(b, nb, sizeof(int));
+        if (round / 4 % 2)
+            ia = filter_iterator(ia, keep_all);
+        if (round / 8 % 2)
+            ib = filter_iterator(ib, keep_all);
+        Iterator set = set_operation_iterator(ia, ib, op, compare_int);
+        bad += count_mismatches(&set, expected, n, round / 16 % 2);
+        iterator_destroy(&set);
+    }
+    CHECK(bad == 0);
+
+    // Rangos y filtros sobre rangos: sus elementos no son estables
+    for (int op = SET_UNION; op <= SET_SYMMETRIC_DIFFERENCE; op++) {
+        for (int i = 0; i < 1000; i++)
+            a[i] = 2 * i;
+        for (int i = 0; i < 700; i++)
+            b[i] = 500 + i;
+        size_t n = reference(a, 1000, b, 700, (SetOperation)op, expected);
+        for (int batches = 0; batches < 2; batches++) {
+            Iterator set = set_operation_iterator(filter_iterator(create_range_iterator(0, 2000, 1), is_even),
+                                                  create_range_iterator(500, 1200, 1), (SetOperation)op, compare_int);
+            CHECK(!iterator_stable_elements(&set));
+            CHECK(count_mismatches(&set, expected, n, batches) == 0);
+            iterator_destroy(&set);
+        }
+    }
+
+    // Una entrada pequeña contra una enorme: la intersección galopa en vez de recorrerla
+    static int big[1000000];
+    for (int i = 0; i < 1000000; i++)
+        big[i] = 2 * i;
+    int small[100];
+    for (int i = 0; i < 100; i++)
+        small[i] = i * 20000 + (i & 1);
+    Iterator set = set_intersection(create_generic_array_iterator(small, 100, sizeof(int)),
+                                    create_generic_array_iterator(big, 1000000, sizeof(int)), compare_int);
+    comparisons = 0;
+    size_t hits = 0;
+    while (iterator_next(&set))
+        hits++;
+    printf("intersección 100 x 1000000: %zu comparaciones\n", comparisons);
+    CHECK(hits == 50);
+    CHECK(comparisons < 10000);
+    iterator_destroy(&set);
+
+    // Las funciones de conveniencia y las entradas vacías
+    int one[] = { 1, 1, 2 }, other[] = { 1, 3 };
+    set = set_union(create_generic_array_iterator(one, 3, sizeof(int)),
+                    create_generic_array_iterator(other, 2, sizeof(int)), compare_int);
+    CHECK(count_mismatches(&set, (int[]){ 1, 1, 2, 3 }, 4, false) == 0);
+    iterator_destroy(&set);
+    set = set_difference(create_generic_array_iterator(one, 3, sizeof(int)),
+                         create_generic_array_iterator(other, 2, sizeof(int)), compare_int);
+    CHECK(count_mismatches(&set, (int[]){ 1, 2 }, 2, true) == 0);
+    iterator_destroy(&set);
+    set = set_symmetric_difference(create_generic_array_iterator(one, 0, sizeof(int)),
+                                   create_generic_array_iterator(other, 2, sizeof(int)), compare_int);
+    CHECK(count_mismatches(&set, other, 2, false) == 0);
+    iterator_destroy(&set);
+
+    return check_report("set_operations");
+}
@@ -0,0 +1,89 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de ordenación en el propio buffer: generic_sort_records con
+// registros de distintos tamaños y generic_sort_inplace sobre un iterador.
+// Cada registro lleva un identificador y una carga derivada de él, así que se
+// comprueba que el buffer queda ordenado y que ningún registro se mezcla.
+
+typedef struct Record4  { int key; } Record4;
+typedef struct Record16 { int key; int id; long long payload; } Record16;
+typedef struct Record40 { int key; int id; char payload[32]; } Record40;
+
+static int compare_key(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+#define N 20000
+
+int main() {
+    unsigned long long seed = 7;
+
+    // 4 bytes: basta con que quede ordenado y sea el mismo multiconjunto de claves
+    static Record4 r4[N];
+    long long sum_before = 0, sum_after = 0;
+    for (int i = 0; i < N; i++) {
+        r4[i].key = (int)(check_random(&seed) % 1000);
+        sum_before += r4[i].key;
+    }
+    generic_sort_records(r4, N, sizeof(Record4), compare_key);
+    for (int i = 0; i < N; i++) {
+        sum_after += r4[i].key;
+        if (i > 0)
+            CHECK(r4[i - 1].key <= r4[i].key);
+    }
+    CHECK(sum_before == sum_after);
+
+    // 16 bytes: cada registro debe seguir entero
+    static Record16 r16[N];
+    for (int i = 0; i < N; i++)
+        r16[i] = (Record16){ (int)(check_random(&seed) % 5000), i, (long long)i * 1000003 };
+    generic_sort_records(r16, N, sizeof(Record16), compare_key);
+    static bool seen[N];
+    size_t bad = 0;
+    for (int i = 0; i < N; i++) {
+        bad += r16[i].payload != (long long)r16[i].id * 1000003 || seen[r16[i].id];
+        seen[r16[i].id] = true;
+        if (i > 0)
+            bad += r16[i - 1].key > r16[i].key;
+    }
+    CHECK(bad == 0);
+
+    // 40 bytes (camino genérico con memcpy), ordenado a través del iterador
+    static Record40 r40[N];
+    for (int i = 0; i < N; i++) {
+        r40[i].key = (int)(check_random(&seed) % 100000);
+        r40[i].id = i;
+        memset(r40[i].payload, i & 0xFF, sizeof(r40[i].payload));
+    }
+    Iterator it = create_generic_array_iterator(r40, N, sizeof(Record40));
+    generic_sort(&it, compare_key); // La tabla de punteros que crea se libera en generic_sort_inplace
+    generic_sort_inplace(&it, compare_key);
+    bad = 0;
+    for (int i = 0; i < N; i++) {
+        bad += r40[i].payload[0] != (char)(r40[i].id & 0xFF) || r40[i].payload[31] != (char)(r40[i].id & 0xFF);
+        if (i > 0)
+            bad += r40[i - 1].key > r40[i].key;
+    }
+    CHECK(bad == 0);
+
+    // Tras ordenar en su sitio, recorrer el iterador es recorrer el buffer
+    for (size_t i = 0; i < N; i += 997)
+        CHECK(iterator_at(&it, i) == &r40[i]);
+    iterator_destroy(&it);
+
+    // Con stride, solo se reordena la columna del iterador
+    Record16 rows[6] = { { 3, 0, 0 }, { 1, 1, 0 }, { 2, 2, 0 }, { 6, 3, 0 }, { 5, 4, 0 }, { 4, 5, 0 } };
+    Iterator keys = create_strided_array_iterator(&rows[0].key, 6, sizeof(int), sizeof(Record16));
+    generic_sort_inplace(&keys, compare_key);
+    for (int i = 0; i < 6; i++) {
+        CHECK(rows[i].key == i + 1);
+        CHECK(rows[i].id == i);
+    }
+    iterator_destroy(&keys);
+
+    return check_report("sort_inplace");
+}
@@ -0,0 +1,85 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de sorted_iterator: entrega en orden los elementos de otro
+// iterador ordenando solo lo que se consume. Se compara con el array
+// ordenado, se cuentan las comparaciones al pedir solo los primeros y se
+// comprueba que una fuente sin elementos estables se rechaza.
+
+static size_t comparisons = 0;
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    comparisons++;
+    return (x > y) - (x < y);
+}
+
+static bool keep_all(void *element) {
+    return element != NULL;
+}
+
+#define N 100000
+
+int main() {
+    static int data[N], sorted[N];
+    unsigned long long seed = 4242;
+
+    for (size_t i = 0; i < N; i++)
+        data[i] = sorted[i] = (int)(check_random(&seed) % 1000000);
+    generic_sort_int32_array(sorted, N);
+
+    // Recorrido completo con next(): mismo orden que el array ordenado
+    Iterator it = sorted_iterator(create_generic_array_iterator(data, N, sizeof(int)), compare_int);
+    CHECK(it.impl != NULL);
+    size_t count = 0, bad = 0;
+    while (iterator_next(&it)) {
+        bad += count >= N || *(int *)iterator_deref(&it) != sorted[count];
+        count++;
+    }
+    CHECK(bad == 0 && count == N);
+    CHECK(iterator_deref(&it) == NULL);
+    iterator_destroy(&it);
+
+    // Por lotes
+    it = sorted_iterator(create_generic_array_iterator(data, N, sizeof(int)), compare_int);
+    void *batch[ITERATOR_BATCH_SIZE];
+    size_t got;
+    count = bad = 0;
+    while ((got = iterator_next_batch(&it, batch, ITERATOR_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < got; i++, count++)
+            bad += count >= N || *(int *)batch[i] != sorted[count];
+    }
+    CHECK(bad == 0 && count == N);
+    CHECK(iterator_deref(&it) == NULL);
+    iterator_destroy(&it);
+
+    // Los 10 primeros de 100k cuestan mucho menos que ordenarlo todo
+    comparisons = 0;
+    it = sorted_iterator(create_generic_array_iterator(data, N, sizeof(int)), compare_int);
+    for (size_t i = 0; i < 10; i++)
+        CHECK(iterator_next(&it) && *(int *)iterator_deref(&it) == sorted[i]);
+    printf("10 primeros de %d: %zu comparaciones\n", N, comparisons);
+    CHECK(comparisons < 4 * (size_t)N);
+    iterator_destroy(&it);
+
+    // La fuente puede ser cualquier iterador con elementos estables
+    it = sorted_iterator(filter_iterator(create_generic_array_iterator(data, N, sizeof(int)), keep_all), compare_int);
+    CHECK(it.impl != NULL);
+    CHECK(iterator_next(&it) && *(int *)iterator_deref(&it) == sorted[0]);
+    iterator_destroy(&it);
+
+    // Un rango reutiliza sus valores: no se puede materializar y se rechaza
+    Iterator range = create_range_iterator(0, 10, 1);
+    it = sorted_iterator(range, compare_int);
+    CHECK(it.impl == NULL);
+    iterator_destroy(&range);
+
+    // Fuente vacía
+    it = sorted_iterator(create_generic_array_iterator(data, 0, sizeof(int)), compare_int);
+    CHECK(iterator_next(&it) == NULL);
+    iterator_destroy(&it);
+
+    return check_report("sorted_iterator");
+}
@@ -0,0 +1,89 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de las hojas con redes de ordenación de las ordenaciones tipadas:
+// se ordenan muchos arrays pequeños de todos los tamaños que cubren las
+// redes (y algo más), con valores extremos iguales al centinela de relleno,
+// duplicados y NaN, y se comparan con qsort. Sin AVX2 se prueban igualmente
+// las hojas escalares.
+
+#define MAX_SIZE 140
+#define ROUNDS 40
+
+#define DEFINE_COMPARE(name, type)                              \
+    static int compare_##name(const void *a, const void *b) {  \
+        type x = *(const type *)a, y = *(const type *)b;        \
+        return (x > y) - (x < y);                               \
+    }
+
+DEFINE_COMPARE(int32, int32_t)
+DEFINE_COMPARE(uint32, uint32_t)
+DEFINE_COMPARE(int64, int64_t)
+DEFINE_COMPARE(double, double)
+
+// Valor de prueba: mezcla de aleatorios, pocos valores repetidos y extremos
+#define TEST_VALUE(type, min, max, seed)                                      \
+    (check_random(seed) % 8 == 0 ? (check_random(seed) & 1 ? (type)(max) : (type)(min)) \
+     : check_random(seed) % 3 == 0 ? (type)(check_random(seed) % 4) : (type)check_random(seed))
+
+#define CHECK_NETWORKS(name, type, min, max)                                   \
+    do {                                                                       \
+        type data[MAX_SIZE], expected[MAX_SIZE];                               \
+        size_t bad = 0;                                                        \
+        for (size_t n = 0; n <= MAX_SIZE; n++) {                               \
+            for (int round = 0; round < ROUNDS; round++) {                     \
+                for (size_t i = 0; i < n; i++)                                 \
+                    data[i] = expected[i] = TEST_VALUE(type, min, max, &seed); \
+                qsort(expected, n, sizeof(type), compare_##name);              \
+                generic_sort_##name##_array(data, n);                          \
+                bad += n && memcmp(data, expected, n * sizeof(type)) != 0;     \
+            }                                                                  \
+        }                                                                      \
+        CHECK(bad == 0);                                                       \
+    } while (0)
+
+int main() {
+    unsigned long long seed = 314159;
+
+    CHECK_NETWORKS(int32, int32_t, INT32_MIN, INT32_MAX);
+    CHECK_NETWORKS(uint32, uint32_t, 0, UINT32_MAX);
+    CHECK_NETWORKS(int64, int64_t, INT64_MIN, INT64_MAX);
+
+    // Flotantes: sin NaN deben coincidir con qsort (incluidos los infinitos)
+    double doubles[MAX_SIZE], expected[MAX_SIZE];
+    size_t bad = 0;
+    for (size_t n = 0; n <= MAX_SIZE; n++) {
+        for (int round = 0; round < ROUNDS; round++) {
+            for (size_t i = 0; i < n; i++) {
+                unsigned long long r = check_random(&seed);
+                doubles[i] = r % 10 == 0 ? (r & 16 ? INFINITY : -INFINITY) : (double)(int64_t)r / 1e6;
+                expected[i] = doubles[i];
+            }
+            qsort(expected, n, sizeof(double), compare_double);
+            generic_sort_double_array(doubles, n);
+            bad += n && memcmp(doubles, expected, n * sizeof(double)) != 0;
+        }
+    }
+    CHECK(bad == 0);
+
+    // Un bloque con NaN pasa por la hoja escalar: los NaN quedan al final
+    float floats[MAX_SIZE];
+    for (size_t n = 1; n <= 64; n++) {
+        size_t nans = 0;
+        for (size_t i = 0; i < n; i++) {
+            floats[i] = check_random(&seed) % 5 == 0 ? NAN : (float)(check_random(&seed) % 1000);
+            nans += isnan(floats[i]);
+        }
+        generic_sort_float_array(floats, n);
+        for (size_t i = 0; i < n; i++) {
+            if (i >= n - nans)
+                CHECK(isnan(floats[i]));
+            else if (i > 0)
+                CHECK(floats[i - 1] <= floats[i]);
+        }
+    }
+
+    return check_report("sorting_networks");
+}
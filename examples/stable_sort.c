@@ -0,0 +1,85 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de la ordenación estable: estabilidad con claves repetidas, con y
+// sin buffer auxiliar del llamador, ordenación por dos claves en dos pasadas
+// y coste casi lineal en entradas ya ordenadas por tramos.
+
+typedef struct Person {
+    int age;
+    int city;
+    int id;
+} Person;
+
+static size_t comparisons = 0;
+
+static int by_age(const void *a, const void *b) {
+    int x = ((const Person *)a)->age, y = ((const Person *)b)->age;
+    comparisons++;
+    return (x > y) - (x < y);
+}
+
+static int by_city(const void *a, const void *b) {
+    int x = ((const Person *)a)->city, y = ((const Person *)b)->city;
+    return (x > y) - (x < y);
+}
+
+#define N 100000
+
+// Estable por edad: a igual edad, los ids (orden de entrada) siguen crecientes
+static size_t unstable_pairs(const Person *a, const Person *b) {
+    return a->age > b->age || (a->age == b->age && a->id > b->id);
+}
+
+int main() {
+    static Person people[N];
+    unsigned long long seed = 11;
+
+    for (int i = 0; i < N; i++)
+        people[i] = (Person){ (int)(check_random(&seed) % 90), (int)(check_random(&seed) % 50), i };
+
+    // Vista con buffer auxiliar del llamador
+    size_t scratch_size = generic_stable_sort_scratch_size(N, sizeof(void *));
+    void *scratch = malloc(scratch_size);
+    Iterator it = create_generic_array_iterator(people, N, sizeof(Person));
+    CHECK(generic_stable_sort(&it, by_age, scratch, scratch_size));
+    size_t bad = 0;
+    for (size_t i = 1; i < N; i++)
+        bad += unstable_pairs(iterator_at(&it, i - 1), iterator_at(&it, i));
+    CHECK(bad == 0);
+    iterator_destroy(&it);
+    free(scratch);
+
+    // Registros: primero por ciudad y después, de forma estable, por edad;
+    // el resultado queda ordenado por (edad, ciudad)
+    CHECK(generic_stable_sort_records(people, N, sizeof(Person), by_city, NULL, 0));
+    CHECK(generic_stable_sort_records(people, N, sizeof(Person), by_age, NULL, 0));
+    bad = 0;
+    for (size_t i = 1; i < N; i++) {
+        const Person *a = &people[i - 1], *b = &people[i];
+        bad += a->age > b->age || (a->age == b->age && a->city > b->city);
+        bad += a->age == b->age && a->city == b->city && a->id > b->id;
+    }
+    CHECK(bad == 0);
+
+    // Entrada formada por 4 tramos ordenados: detectarlos y fusionarlos cuesta unas 3n comparaciones
+    for (int i = 0; i < N; i++)
+        people[i] = (Person){ i % (N / 4), 0, i };
+    comparisons = 0;
+    CHECK(generic_stable_sort_records(people, N, sizeof(Person), by_age, NULL, 0));
+    bad = 0;
+    for (size_t i = 1; i < N; i++)
+        bad += unstable_pairs(&people[i - 1], &people[i]);
+    CHECK(bad == 0);
+    CHECK(comparisons < 4 * (size_t)N);
+    printf("4 tramos, n=%d: %zu comparaciones\n", N, comparisons);
+
+    // Ya ordenada: una sola pasada
+    comparisons = 0;
+    CHECK(generic_stable_sort_records(people, N, sizeof(Person), by_age, NULL, 0));
+    CHECK(comparisons < 2 * (size_t)N);
+
+    return check_report("stable_sort");
+}
@@ -0,0 +1,68 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de las ordenaciones de cadenas (multikey quicksort): prefijos
+// comunes largos, cadenas vacías, repetidas y con bytes por encima de 127,
+// comparadas con qsort + strcmp.
+
+#define N 30000
+#define MAX_LEN 40
+
+static int compare_string(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+int main() {
+    static char storage[N][MAX_LEN + 1];
+    static const char *array[N], *view_source[N], *expected[N];
+    static const char *prefixes[] = { "", "a", "https://example.com/", "https://example.com/api/v1/", "\xc3\xb1" };
+    unsigned long long seed = 999;
+
+    for (size_t i = 0; i < N; i++) {
+        const char *prefix = prefixes[check_random(&seed) % 5];
+        size_t len = strlen(prefix);
+        memcpy(storage[i], prefix, len);
+        size_t extra = check_random(&seed) % 10;
+        if (len + extra > MAX_LEN)
+            extra = MAX_LEN - len;
+        for (size_t j = 0; j < extra; j++) {
+            unsigned long long r = check_random(&seed) % 5;
+            storage[i][len + j] = r == 4 ? (char)0xE9 : (char)('a' + r); // Alfabeto pequeño: muchos repetidos
+        }
+        storage[i][len + extra] = '\0';
+        array[i] = view_source[i] = expected[i] = storage[i];
+    }
+    qsort(expected, N, sizeof(char *), compare_string);
+
+    generic_sort_str_array(array, N);
+    size_t bad = 0;
+    for (size_t i = 0; i < N; i++)
+        bad += strcmp(array[i], expected[i]) != 0;
+    CHECK(bad == 0);
+
+    // La vista del iterador: se permuta la tabla de punteros, no el array
+    Iterator it = create_string_array_iterator(view_source, N);
+    generic_sort_str(&it);
+    bad = 0;
+    for (size_t i = 0; i < N; i++)
+        bad += strcmp(*(const char **)iterator_at(&it, i), expected[i]) != 0;
+    CHECK(bad == 0);
+    CHECK(view_source[0] == storage[0]);
+    iterator_destroy(&it);
+
+    // Tamaños pequeños y todas iguales
+    const char *same[100];
+    for (size_t i = 0; i < 100; i++)
+        same[i] = "igual";
+    generic_sort_str_array(same, 100);
+    CHECK(strcmp(same[0], "igual") == 0 && strcmp(same[99], "igual") == 0);
+
+    const char *two[] = { "b", "a" };
+    generic_sort_str_array(two, 2);
+    CHECK(strcmp(two[0], "a") == 0);
+    generic_sort_str_array(two, 0);
+
+    return check_report("string_sort");
+}
@@ -0,0 +1,76 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de las ordenaciones sin comparador para tipos primitivos, tanto
+// sobre arrays (generic_sort_<tipo>_array) como sobre la vista de un
+// iterador (generic_sort_<tipo>), comparadas con qsort.
+
+#define N 50000
+
+#define DEFINE_COMPARE(name, type)                              \
+    static int compare_##name(const void *a, const void *b) {  \
+        type x = *(const type *)a, y = *(const type *)b;        \
+        return (x > y) - (x < y);                               \
+    }
+
+DEFINE_COMPARE(int32, int32_t)
+DEFINE_COMPARE(int64, int64_t)
+DEFINE_COMPARE(uint32, uint32_t)
+DEFINE_COMPARE(uint64, uint64_t)
+DEFINE_COMPARE(double, double)
+
+// Comprueba un tipo: ordena una copia con el array, otra con la vista y una
+// tercera con qsort, y las tres deben coincidir
+#define CHECK_TYPE(name, type, value)                                                  \
+    do {                                                                               \
+        static type data[N], view_data[N], expected[N];                                \
+        for (size_t i = 0; i < N; i++)                                                 \
+            data[i] = view_data[i] = expected[i] = (type)(value);                      \
+        qsort(expected, N, sizeof(type), compare_##name);                              \
+        generic_sort_##name##_array(data, N);                                          \
+        Iterator it = create_generic_array_iterator(view_data, N, sizeof(type));       \
+        generic_sort_##name(&it);                                                      \
+        size_t bad = 0;                                                                \
+        for (size_t i = 0; i < N; i++)                                                 \
+            bad += data[i] != expected[i] || *(type *)iterator_at(&it, i) != expected[i]; \
+        CHECK(bad == 0);                                                               \
+        iterator_destroy(&it);                                                         \
+    } while (0)
+
+int main() {
+    unsigned long long seed = 2024;
+
+    CHECK_TYPE(int32, int32_t, check_random(&seed));
+    CHECK_TYPE(int32, int32_t, (int32_t)(check_random(&seed) % 16) - 8);
+    CHECK_TYPE(int64, int64_t, check_random(&seed));
+    CHECK_TYPE(uint32, uint32_t, check_random(&seed));
+    CHECK_TYPE(uint64, uint64_t, check_random(&seed));
+    CHECK_TYPE(uint64, uint64_t, i);
+    CHECK_TYPE(double, double, (double)(int64_t)check_random(&seed) / 1e9);
+
+    // Los NaN van al final; el resto queda en orden
+    float floats[] = { 3.5f, NAN, -1.0f, 0.0f, NAN, -1e30f, 1e30f, 2.25f };
+    generic_sort_float_array(floats, 8);
+    for (int i = 0; i < 5; i++)
+        CHECK(floats[i] < floats[i + 1]);
+    CHECK(floats[0] == -1e30f && floats[5] == 1e30f);
+    CHECK(isnan(floats[6]) && isnan(floats[7]));
+
+    double doubles[] = { NAN, 1.0, -INFINITY, 0.5, INFINITY };
+    Iterator dit = create_generic_array_iterator(doubles, 5, sizeof(double));
+    generic_sort_double(&dit);
+    CHECK(*(double *)iterator_at(&dit, 0) == -INFINITY);
+    CHECK(*(double *)iterator_at(&dit, 3) == INFINITY);
+    CHECK(isnan(*(double *)iterator_at(&dit, 4)));
+    iterator_destroy(&dit);
+
+    // Cadenas en el orden de strcmp
+    const char *words[] = { "pera", "", "manzana", "man", "zanahoria", "manzanas", "a" };
+    generic_sort_str_array(words, 7);
+    for (int i = 0; i < 6; i++)
+        CHECK(strcmp(words[i], words[i + 1]) <= 0);
+
+    return check_report("typed_sort");
+}
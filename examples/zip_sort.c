@@ -0,0 +1,97 @@
+#include "CSortting.h"
+#include "check.h"
+
+#include <stdlib.h>
+
+// Ejemplo de generic_sort_zip: ordena las filas de tres columnas paralelas
+// por una o dos columnas clave, moviendo cada fila en todas las columnas, y
+// después recorre el zip por lotes.
+
+#define N 50000
+
+static int compare_by_age(const void *a, const void *b) {
+    void *const *x = a, *const *y = b;
+    int p = *(const int *)x[0], q = *(const int *)y[0];
+    return (p > q) - (p < q);
+}
+
+// Por ciudad y, a igual ciudad, por sueldo descendente
+static int compare_city_salary(const void *a, const void *b) {
+    void *const *x = a, *const *y = b;
+    int c = *(const short *)x[0] - *(const short *)y[0];
+    if (c != 0)
+        return c;
+    double p = *(const double *)x[1], q = *(const double *)y[1];
+    return (p < q) - (p > q);
+}
+
+int main() {
+    static int ages[N];
+    static short cities[N];
+    static double salaries[N];
+    unsigned long long seed = 64;
+
+    // El sueldo codifica la fila original para comprobar que las filas no se mezclan
+    for (int i = 0; i < N; i++) {
+        ages[i] = (int)(check_random(&seed) % 80);
+        cities[i] = (short)(check_random(&seed) % 30);
+        salaries[i] = i + ages[i] / 100.0 + cities[i] / 10000.0;
+    }
+
+    Iterator columns[3] = {
+        create_generic_array_iterator(ages, N, sizeof(int)),
+        create_generic_array_iterator(cities, N, sizeof(short)),
+        create_generic_array_iterator(salaries, N, sizeof(double))
+    };
+    Iterator zip = multi_zip_iterators(columns, 3);
+
+    size_t age_key[] = { 0 };
+    CHECK(generic_sort_zip(&zip, age_key, 1, compare_by_age));
+    size_t bad = 0;
+    for (int i = 0; i < N; i++) {
+        int row = (int)salaries[i];
+        bad += salaries[i] != row + ages[i] / 100.0 + cities[i] / 10000.0;
+        if (i > 0)
+            bad += ages[i - 1] > ages[i];
+    }
+    CHECK(bad == 0);
+
+    size_t city_salary_keys[] = { 1, 2 };
+    CHECK(generic_sort_zip(&zip, city_salary_keys, 2, compare_city_salary));
+    bad = 0;
+    for (int i = 0; i < N; i++) {
+        int row = (int)salaries[i];
+        bad += salaries[i] != row + ages[i] / 100.0 + cities[i] / 10000.0;
+        if (i > 0)
+            bad += cities[i - 1] > cities[i] || (cities[i - 1] == cities[i] && salaries[i - 1] < salaries[i]);
+    }
+    CHECK(bad == 0);
+
+    // El zip entrega las filas en el orden nuevo
+    void *batch[ITERATOR_BATCH_SIZE];
+    size_t got, rows = 0;
+    bad = 0;
+    while ((got = iterator_next_batch(&zip, batch, ITERATOR_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < got; i++, rows++) {
+            void **tuple = batch[i];
+            bad += tuple[0] != &ages[rows] || tuple[1] != &cities[rows] || tuple[2] != &salaries[rows];
+        }
+    }
+    CHECK(bad == 0 && rows == N);
+
+    // Columna clave inexistente
+    size_t missing_key[] = { 3 };
+    CHECK(!generic_sort_zip(&zip, missing_key, 1, compare_by_age));
+    iterator_destroy(&zip);
+
+    // Solo vale un zip de arrays
+    Iterator mixed[2] = {
+        create_generic_array_iterator(ages, N, sizeof(int)),
+        create_range_iterator(0, N, 1)
+    };
+    zip = multi_zip_iterators(mixed, 2);
+    CHECK(!generic_sort_zip(&zip, NULL, 0, compare_by_age));
+    iterator_destroy(&zip);
+
+    return check_report("zip_sort");
+}
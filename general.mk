@@ -7,12 +7,16 @@ generate_lib: $(TARGET).a
 all: generate_lib
 	$(MAKE) -C . -f $(MAKE_NAME) examples
 
-TESTS = code code1  
+TESTS = code code1 batches random_access pdqsort sort_inplace typed_sort radix_sort parallel_sort stable_sort sorting_networks selection external_sort sorted_iterator binary_search search_index argsort zip_sort cached_sort string_sort block_partition adaptive_sort merge_iterators set_operations hash_join
 
 # Regla principal que genera todos los tests
 examples: generate_lib $(addprefix $(PATH_EXAMPLES)/, $(addsuffix .$(EXTENSION), $(TESTS)))
 	@echo "generando tests... $^"
 
+# Ejecuta todos los tests; falla en el primero que devuelva error
+test: examples
+	for t in $(TESTS); do ./$(PATH_EXAMPLES)/$$t.$(EXTENSION) || exit 1; done
+
 # Regla patrón: compila cada test a partir de su fuente .c
 $(PATH_EXAMPLES)/%.$(EXTENSION): $(PATH_EXAMPLES)/%.c
 	$(CC) $< $(CFLAGS_EXAMPLES) -o $@ 
@@ -44,4 +48,4 @@ cleanall: cleanobj
 
 .SILENT: clean cleanobj cleanall
 .IGNORE: cleanobj cleanall
-.PHONY:  cleanobj cleanall
\ No newline at end of file
+.PHONY:  cleanobj cleanall test
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+ * @file CExternalSort.h
+ * @brief Ordenación externa (merge sort sobre disco) de registros de tamaño fijo
+ *
+ * Para entradas que no caben en memoria: los registros se leen por bloques
+ * que respetan un presupuesto de memoria, cada bloque se ordena con el motor
+ * en memoria (generic_sort_records) y se vuelca a un fichero temporal, y los
+ * tramos resultantes se fusionan con una fusión de k vías. Toda la E/S es
+ * secuencial.
+ *
+ * Los iteradores de ordenación externa entregan punteros a los bloques de
+ * lectura de la fusión: cada registro (o cada lote de iterator_next_batch)
+ * solo es válido hasta la siguiente llamada. Para conservar registros hay
+ * que copiarlos.
+ */
+
+#ifndef CEXTERNALSORT_H
+#define CEXTERNALSORT_H
+
+#include "CSortting.h"
+
+/**
+ * @def EXTERNAL_SORT_MIN_BLOCK
+ * @brief Tamaño mínimo en bytes del buffer de lectura de cada tramo durante la
+ *        fusión. Si el presupuesto no da para un bloque así por tramo, la
+ *        fusión se hace en varias pasadas.
+ */
+#ifndef EXTERNAL_SORT_MIN_BLOCK
+#define EXTERNAL_SORT_MIN_BLOCK (64 * 1024)
+#endif
+
+bool generic_external_sort(int in_fd, int out_fd, size_t element_size,
+                           CompareFunc compare, size_t memory_budget);
+
+bool generic_external_sort_region(const void *data, size_t size, int out_fd, size_t element_size,
+                                  CompareFunc compare, size_t memory_budget);
+
+Iterator external_sort_iterator(int in_fd, size_t element_size,
+                                CompareFunc compare, size_t memory_budget);
+
+Iterator external_sort_region_iterator(const void *data, size_t size, size_t element_size,
+                                       CompareFunc compare, size_t memory_budget);
+
+#endif // CEXTERNALSORT_H
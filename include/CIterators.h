@@ -10,6 +10,16 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @def ITERATOR_BATCH_SIZE
+ * @brief Tamaño del buffer de lote que usan internamente los consumidores
+ *        (iterator_foreach, iterator_to_array, ...) y los adaptadores.
+ */
+#ifndef ITERATOR_BATCH_SIZE
+#define ITERATOR_BATCH_SIZE 64
+#endif
 
 /**
  * @enum IteratorCategory
@@ -27,35 +37,122 @@ typedef enum {
     MAP_ITERATOR            /**< Iterador que transforma elementos mediante una función. */
 } IteratorCategory;
 
+struct Iterator;
+
 /**
- * @struct Iterator
- * @brief Interfaz genérica para iteradores.
+ * @struct IteratorOps
+ * @brief Tabla de operaciones (vtable) compartida por todos los iteradores de un mismo tipo.
  *
- * Define las funciones básicas que debe tener cualquier iterador.
+ * Cada tipo de iterador define una única instancia `static const` de esta tabla,
+ * y cada Iterator solo guarda un puntero a ella.
+ *
+ * Los elementos que escribe next_batch son válidos al menos hasta la siguiente
+ * llamada sobre el iterador. Un adaptador que lee sus fuentes por lotes corta
+ * el suyo antes de pedir otro lote a una fuente de la que aún tiene elementos
+ * sin entregar o ya entregados en esta llamada, porque el lote nuevo puede
+ * reutilizar la memoria del anterior (por ejemplo en un RangeIterator).
  */
-typedef struct Iterator {
+typedef struct IteratorOps {
     void* (*next)(struct Iterator*);                                /**< Avanza al siguiente elemento y lo devuelve. */
     bool  (*equal)(const struct Iterator*, const struct Iterator*); /**< Compara dos iteradores. */
     void* (*deref)(const struct Iterator*);                         /**< Devuelve el elemento actual sin avanzar. */
     void  (*destroy)(struct Iterator*);                             /**< Libera recursos del iterador. */
-    IteratorCategory category;                                      /**< Categoría del iterador. */
-    void* impl;                                                     /**< Implementación interna del iterador (puntero a struct concreta). */
-    void* current;                                                  /**< Elemento actual del iterador. */
+    size_t (*next_batch)(struct Iterator*, void**, size_t);         /**< Avanza hasta N elementos de golpe (opcional, NULL = usar next). */
+    bool  (*stable_elements)(const struct Iterator*);               /**< Si los elementos entregados siguen siendo válidos al avanzar (opcional, NULL = no). */
+
+    /* Operaciones de acceso aleatorio (opcionales, NULL si el iterador no las soporta) */
+    bool      (*advance_by)(struct Iterator*, size_t);                      /**< Avanza N posiciones en O(1). */
+    ptrdiff_t (*distance)(const struct Iterator*, const struct Iterator*);  /**< Posiciones de A hasta B. */
+    void*     (*at)(struct Iterator*, size_t);                              /**< Elemento i-ésimo desde el inicio, sin mover el iterador. */
+    size_t    (*size)(const struct Iterator*);                              /**< Número total de elementos. */
+} IteratorOps;
+
+/**
+ * @struct Iterator
+ * @brief Interfaz genérica para iteradores.
+ *
+ * Un puntero a la tabla de operaciones del tipo, la categoría, la implementación
+ * concreta y el elemento actual.
+ */
+typedef struct Iterator {
+    const IteratorOps* ops;    /**< Tabla de operaciones compartida del tipo de iterador. */
+    IteratorCategory category; /**< Categoría del iterador. */
+    void* impl;                /**< Implementación interna del iterador (puntero a struct concreta). */
+    void* current;             /**< Elemento actual del iterador. */
 } Iterator;
 
+/**
+ * @brief Avanza el iterador al siguiente elemento.
+ * @param it Iterador.
+ * @return El propio iterador si hay elemento, NULL si se ha agotado.
+ */
+static inline void *iterator_next(Iterator *it)
+{
+    return it->ops->next(it);
+}
+
+/**
+ * @brief Compara dos iteradores del mismo tipo.
+ * @param a Iterador A.
+ * @param b Iterador B.
+ * @return true si ambos están en la misma posición.
+ */
+static inline bool iterator_equal(const Iterator *a, const Iterator *b)
+{
+    return a->ops->equal(a, b);
+}
+
+/**
+ * @brief Devuelve el elemento actual sin avanzar.
+ * @param it Iterador.
+ * @return Puntero al elemento actual.
+ */
+static inline void *iterator_deref(const Iterator *it)
+{
+    return it->ops->deref(it);
+}
+
+/**
+ * @brief Libera los recursos del iterador.
+ * @param it Iterador a destruir.
+ */
+static inline void iterator_destroy(Iterator *it)
+{
+    it->ops->destroy(it);
+}
+
 /**
  * @struct GenericArrayIterator
- * @brief Iterador para recorrer arrays genéricos de punteros.
+ * @brief Iterador para recorrer arrays genéricos contiguos o con paso (stride).
  *
- * Permite recorrer un array de punteros void* con soporte para tamaños y posición actual.
+ * La dirección de cada elemento se calcula al vuelo como `base + index * stride`,
+ * por lo que crear el iterador es O(1) y no reserva memoria por elemento.
+ * La tabla `elements` solo existe si alguien necesita una vista permutada del
+ * array (por ejemplo generic_sort), y en ese caso tiene prioridad sobre `base`.
  */
 typedef struct GenericArrayIterator {
-    void** elements;      /**< Array de punteros a elementos. */
+    void** elements;      /**< Tabla opcional de punteros a elementos (NULL = acceso directo). */
+    char*  base;          /**< Dirección del primer elemento del array original. */
     size_t index;         /**< Índice actual del iterador. */
     size_t size;          /**< Número total de elementos en el array. */
     size_t element_size;  /**< Tamaño en bytes de cada elemento. */
+    size_t stride;        /**< Distancia en bytes entre dos elementos consecutivos. */
 } GenericArrayIterator;
 
+/**
+ * @brief Devuelve la dirección del elemento i de un GenericArrayIterator.
+ *
+ * @param iter Implementación del iterador.
+ * @param i Índice del elemento (debe ser menor que iter->size).
+ * @return Puntero al elemento, desde la tabla si existe o calculado desde `base`.
+ */
+static inline void *generic_array_get(const GenericArrayIterator *iter, size_t i)
+{
+    if (iter->elements)
+        return iter->elements[i];
+    return iter->base + i * iter->stride;
+}
+
 /**
  * @struct RangeIterator
  * @brief Iterador para generar secuencias numéricas.
@@ -67,6 +164,9 @@ typedef struct RangeIterator {
     int current;  /**< Valor actual del iterador. */
     int end;      /**< Valor final (no inclusivo) de la secuencia. */
     int step;     /**< Incremento entre valores sucesivos. */
+    int probe;             /**< Valor devuelto por at(). */
+    int* slots;            /**< Valores del último lote de next_batch (ITERATOR_BATCH_SIZE, nunca se realoja). */
+    size_t slot_capacity;  /**< Capacidad de `slots`. */
 } RangeIterator;
 
 /**
@@ -74,13 +174,17 @@ typedef struct RangeIterator {
  * @brief Iterador para combinar múltiples iteradores en paralelo.
  *
  * Itera sobre varios iteradores al mismo tiempo, devolviendo una tupla con sus elementos actuales.
+ * Cada fuente se lee por lotes de ITERATOR_BATCH_SIZE elementos y solo se le
+ * pide otro lote cuando el suyo se ha consumido, así que los elementos
+ * pendientes de una columna siguen siendo válidos hasta formar su tupla.
  */
 typedef struct MultiZipIterator {
     Iterator* iterators; /**< Array de iteradores a combinar. */
     size_t count;        /**< Número total de iteradores. */
-    bool* valid;         /**< Array que indica si cada iterador tiene un valor válido. */
-    void** elements;     /**< Array que guarda el valor actual de cada iterador. */
-    bool first;          /**< Bandera que indica si es la primera llamada a `next`. */
+    void** columns;      /**< Lote en curso de cada fuente (ITERATOR_BATCH_SIZE por fuente). */
+    size_t* positions;   /**< Siguiente elemento del lote de cada fuente. */
+    size_t* lengths;     /**< Elementos del lote de cada fuente. */
+    void** tuples;       /**< Tuplas entregadas por la última llamada a next_batch. */
 } MultiZipIterator;
 
 /**
@@ -105,21 +209,39 @@ typedef struct MapIterator {
     void *(*map_fn)(void *);      /**< Función que transforma un elemento. */
 } MapIterator;
 
+extern const IteratorOps generic_array_iterator_ops;
+
 void* generic_array_next(Iterator* it);
 bool generic_array_equal(const Iterator* a, const Iterator* b);
 
 void generic_array_destroy(Iterator* it);
 
+void** generic_array_table(GenericArrayIterator* iter);
+
 Iterator create_generic_array_iterator(void* array, size_t size, size_t element_size);
 
+Iterator create_strided_array_iterator(void* array, size_t size, size_t element_size, size_t stride);
+
 Iterator create_range_iterator(int start, int end, int step);
 
 Iterator filter_iterator(Iterator it, bool (*filter_fn)(void *));
 
 Iterator map_iterator(Iterator it, void *(*map_fn)(void *));
 
+size_t iterator_next_batch(Iterator *it, void **out, size_t max);
+
+bool iterator_stable_elements(const Iterator *it);
+
 bool iterator_advance(Iterator *it, size_t n);
 
+bool iterator_is_random_access(const Iterator *it);
+
+ptrdiff_t iterator_distance(const Iterator *a, const Iterator *b);
+
+void *iterator_at(Iterator *it, size_t i);
+
+size_t iterator_size(const Iterator *it);
+
 void iterator_reset(Iterator *it);
 
 Iterator create_string_array_iterator(const char **array, size_t count);
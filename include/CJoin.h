@@ -0,0 +1,92 @@
+/**
+ * @file CJoin.h
+ * @brief Hash join entre dos iteradores
+ *
+ * Un lado (build) se materializa en una tabla hash de direccionamiento
+ * abierto y el otro (probe) se recorre por lotes buscando cada elemento en
+ * ella, sin materializarlo. A diferencia de multi_zip_iterators, que empareja
+ * por posición, aquí se emparejan los elementos cuyas claves son iguales.
+ */
+
+#ifndef CJOIN_H
+#define CJOIN_H
+
+#include "CIterators.h"
+
+#include <stdint.h>
+
+/**
+ * @typedef JoinKeyFunc
+ * @brief Función que devuelve la clave de join de un elemento
+ * @param element Puntero al elemento
+ * @return Puntero a la clave (normalmente un campo del propio elemento)
+ */
+typedef const void *(*JoinKeyFunc)(const void *element);
+
+/**
+ * @typedef JoinHashFunc
+ * @brief Función hash sobre una clave devuelta por JoinKeyFunc
+ */
+typedef uint64_t (*JoinHashFunc)(const void *key);
+
+/**
+ * @typedef JoinEqualFunc
+ * @brief Indica si dos claves devueltas por JoinKeyFunc son iguales
+ */
+typedef bool (*JoinEqualFunc)(const void *a, const void *b);
+
+/**
+ * @enum JoinMode
+ * @brief Qué entrega un HashJoinIterator.
+ */
+typedef enum JoinMode {
+    JOIN_INNER,     /**< Una tupla `void*[2]` {build, probe} por cada pareja con claves iguales. */
+    JOIN_LEFT_SEMI, /**< Cada elemento de probe con alguna coincidencia en build, una sola vez. */
+    JOIN_ANTI       /**< Cada elemento de probe sin ninguna coincidencia en build. */
+} JoinMode;
+
+/**
+ * @struct JoinEntry
+ * @brief Hueco de la tabla hash; `element` es NULL si está libre.
+ */
+typedef struct JoinEntry {
+    uint64_t hash;      /**< Hash de la clave, para descartar huecos sin llamar a eq_fn. */
+    const void *key;    /**< Clave del elemento. */
+    void *element;      /**< Elemento del lado materializado. */
+} JoinEntry;
+
+/**
+ * @struct HashJoinIterator
+ * @brief Iterador que entrega bajo demanda el resultado de un hash join.
+ *
+ * Al crearlo se materializa el lado de la tabla y se inserta en un único
+ * bloque de huecos con sondeo lineal y carga máxima de 1/2. El lado recorrido se lee por lotes: para cada lote se calculan todas
+ * las claves y hashes y se precargan sus huecos antes de comparar.
+ */
+typedef struct HashJoinIterator {
+    Iterator build;          /**< Iterador build (se destruye con este). */
+    Iterator probe;          /**< Iterador probe (se destruye con este). */
+    JoinMode mode;           /**< Resultado a entregar. */
+    JoinKeyFunc key_fn;      /**< Extractor de clave; NULL = el propio elemento es la clave. */
+    JoinHashFunc hash_fn;    /**< Función hash de las claves. */
+    JoinEqualFunc eq_fn;     /**< Igualdad de claves. */
+    bool swapped;            /**< JOIN_INNER: la tabla se construyó con probe por ser el lado más pequeño. */
+    bool exhausted;          /**< Si el lado recorrido ya no tiene más elementos. */
+    JoinEntry *table;        /**< Tabla hash con los elementos del lado materializado. */
+    size_t mask;             /**< Número de huecos de la tabla menos uno (potencia de dos). */
+    size_t slot;             /**< JOIN_INNER: siguiente hueco a examinar para el elemento en curso. */
+    size_t batch_pos;        /**< Elemento en curso del lote. */
+    size_t batch_len;        /**< Elementos del lote. */
+    void *batch[ITERATOR_BATCH_SIZE];          /**< Lote en curso del lado recorrido. */
+    const void *keys[ITERATOR_BATCH_SIZE];     /**< Claves del lote. */
+    uint64_t hashes[ITERATOR_BATCH_SIZE];      /**< Hashes del lote. */
+    void *tuples[ITERATOR_BATCH_SIZE][2];      /**< Tuplas entregadas en la última llamada (JOIN_INNER). */
+} HashJoinIterator;
+
+Iterator hash_join_iterator(Iterator build, Iterator probe, JoinKeyFunc key_fn,
+                            JoinHashFunc hash_fn, JoinEqualFunc eq_fn);
+
+Iterator hash_join_iterator_mode(Iterator build, Iterator probe, JoinMode mode, JoinKeyFunc key_fn,
+                                 JoinHashFunc hash_fn, JoinEqualFunc eq_fn);
+
+#endif // CJOIN_H
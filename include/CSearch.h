@@ -0,0 +1,150 @@
+/**
+ * @file CSearch.h
+ * @brief Búsqueda binaria sobre la vista ordenada de un GenericArrayIterator
+ *
+ * Las funciones asumen que la vista del iterador (tabla de punteros si existe,
+ * o el array original) está ordenada según `compare`, por ejemplo tras
+ * generic_sort. La comparación recibe siempre (elemento, valor buscado).
+ *
+ * Para muchas búsquedas sobre los mismos datos, SearchIndex reorganiza una
+ * copia en un orden que aprovecha mejor la caché.
+ *
+ * Las operaciones de conjuntos (set_union, set_intersection, ...) recorren
+ * dos iteradores ordenados y usan búsqueda con galope en los que son
+ * GenericArrayIterator.
+ */
+
+#ifndef CSEARCH_H
+#define CSEARCH_H
+
+#include "CSortting.h"
+
+/**
+ * @def SEARCH_PREFETCH_MIN
+ * @brief Número de elementos a partir del cual la búsqueda precarga en caché
+ *        los dos posibles puntos medios del paso siguiente.
+ */
+#ifndef SEARCH_PREFETCH_MIN
+#define SEARCH_PREFETCH_MIN 4096
+#endif
+
+size_t generic_lower_bound(const Iterator *it, const void *value, CompareFunc compare);
+
+size_t generic_upper_bound(const Iterator *it, const void *value, CompareFunc compare);
+
+bool generic_equal_range(const Iterator *it, const void *value, CompareFunc compare,
+                         size_t *first, size_t *last);
+
+void *generic_binary_search(const Iterator *it, const void *value, CompareFunc compare);
+
+/**
+ * @def SEARCH_INDEX_NODE_KEYS
+ * @brief Claves por nodo del B-tree estático de los índices por clave entera:
+ *        8 claves de 64 bits ocupan exactamente una línea de caché.
+ */
+#define SEARCH_INDEX_NODE_KEYS 8
+
+/**
+ * @struct SearchIndex
+ * @brief Índice de solo lectura construido a partir de datos ya ordenados.
+ *
+ * Con una función de comparación, los elementos se copian en orden de
+ * Eytzinger (el hijo izquierdo de la posición k está en 2k y el derecho en
+ * 2k + 1): los niveles superiores del árbol comparten unas pocas líneas de
+ * caché y los descendientes de cuatro niveles más abajo son contiguos, así que
+ * se pueden precargar mientras se compara.
+ *
+ * Con una RadixKey, solo se guardan las claves normalizadas en un B-tree
+ * estático de SEARCH_INDEX_NODE_KEYS claves por nodo alineado a 64 bytes.
+ * Cada nivel cuesta un acceso a memoria y el nodo se compara entero con AVX2
+ * cuando la CPU lo permite.
+ *
+ * En ambos casos las búsquedas devuelven el puntero al elemento original, que
+ * debe seguir siendo válido mientras se use el índice.
+ */
+typedef struct SearchIndex {
+    size_t size;          /**< Número de elementos indexados. */
+    size_t element_size;  /**< Tamaño en bytes de cada elemento. */
+    CompareFunc compare;  /**< Comparación del índice de Eytzinger; NULL en los índices por clave. */
+    RadixKey key;         /**< Clave de los índices por clave entera. */
+    char *records;        /**< Eytzinger: copias de los elementos (la posición 0 no se usa). */
+    int64_t *keys;        /**< B-tree: claves normalizadas con el bit de signo invertido. */
+    size_t nodes;         /**< B-tree: número de nodos. */
+    void **origin;        /**< Elemento original de cada posición; NULL si el índice no es válido. */
+    void *allocation;     /**< Bloque reservado del que se alinean las claves. */
+} SearchIndex;
+
+SearchIndex search_index_build(const Iterator *it, CompareFunc compare);
+
+SearchIndex search_index_build_records(const void *base, size_t count, size_t element_size,
+                                       CompareFunc compare);
+
+SearchIndex search_index_build_keyed(const Iterator *it, const RadixKey *key);
+
+SearchIndex search_index_build_keyed_records(const void *base, size_t count, size_t element_size,
+                                             const RadixKey *key);
+
+void *search_index_lower_bound(const SearchIndex *index, const void *value);
+
+void *search_index_find(const SearchIndex *index, const void *value);
+
+void *search_index_find_key(const SearchIndex *index, uint64_t key);
+
+void search_index_destroy(SearchIndex *index);
+
+/**
+ * @enum SetOperation
+ * @brief Operación que calcula un SetOperationIterator.
+ *
+ * Con elementos repetidos se sigue la semántica de multiconjunto: si un valor
+ * aparece m veces en A y n en B, sale max(m, n) veces en la unión, min(m, n)
+ * en la intersección, max(m - n, 0) en la diferencia y |m - n| en la
+ * diferencia simétrica.
+ */
+typedef enum SetOperation {
+    SET_UNION,               /**< Elementos de A o de B. */
+    SET_INTERSECTION,        /**< Elementos de A y de B. */
+    SET_DIFFERENCE,          /**< Elementos de A que no están en B. */
+    SET_SYMMETRIC_DIFFERENCE /**< Elementos de solo uno de los dos. */
+} SetOperation;
+
+/**
+ * @struct SetSide
+ * @brief Una de las dos entradas de un SetOperationIterator.
+ *
+ * Si la fuente es un GenericArrayIterator se lee directamente de su vista,
+ * lo que permite saltar tramos con búsqueda con galope; si no, se lee por
+ * lotes de ITERATOR_BATCH_SIZE elementos.
+ */
+typedef struct SetSide {
+    Iterator source;                      /**< Iterador fuente (se destruye con el SetOperationIterator). */
+    const GenericArrayIterator *array;    /**< Vista de la fuente si es un GenericArrayIterator, NULL si no. */
+    size_t position;                      /**< Siguiente elemento (en la vista o en el lote). */
+    size_t length;                        /**< Tamaño de la vista, o elementos del lote en curso. */
+    bool exhausted;                       /**< Si la fuente leída por lotes ya no tiene más elementos. */
+    void *buffer[ITERATOR_BATCH_SIZE];    /**< Lote en curso si `array` es NULL. */
+} SetSide;
+
+/**
+ * @struct SetOperationIterator
+ * @brief Iterador que calcula bajo demanda una operación de conjuntos entre dos iteradores ordenados.
+ */
+typedef struct SetOperationIterator {
+    SetSide a;           /**< Primera entrada. */
+    SetSide b;           /**< Segunda entrada. */
+    SetOperation op;     /**< Operación a calcular. */
+    CompareFunc compare; /**< Función de comparación con la que están ordenadas las entradas. */
+    bool done;           /**< Si ya no puede salir ningún elemento más. */
+} SetOperationIterator;
+
+Iterator set_operation_iterator(Iterator a, Iterator b, SetOperation op, CompareFunc compare);
+
+Iterator set_union(Iterator a, Iterator b, CompareFunc compare);
+
+Iterator set_intersection(Iterator a, Iterator b, CompareFunc compare);
+
+Iterator set_difference(Iterator a, Iterator b, CompareFunc compare);
+
+Iterator set_symmetric_difference(Iterator a, Iterator b, CompareFunc compare);
+
+#endif // CSEARCH_H
@@ -1,10 +1,11 @@
 /**
  * @file CSorting.h
- * @brief Implementación del algoritmo Introsort usando iteradores genéricos
+ * @brief Ordenación genérica (pattern-defeating quicksort) usando iteradores genéricos
  * 
  * Este archivo contiene la implementación de un algoritmo de ordenación híbrido
- * (Introsort) que combina QuickSort, HeapSort e Insertion Sort, diseñado para
- * trabajar con la estructura de iteradores genéricos definida en CIterators.h
+ * (pdqsort, derivado de Introsort) que combina QuickSort, HeapSort e Insertion
+ * Sort, diseñado para trabajar con la estructura de iteradores genéricos
+ * definida en CIterators.h
  */
 
 #ifndef CSORTING_H
@@ -13,6 +14,7 @@
 #include "CIterators.h"
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
 
@@ -29,4 +31,187 @@ typedef int (*CompareFunc)(const void*, const void*);
 
 void generic_sort(Iterator *it, CompareFunc compare);
 
+/**
+ * @enum SortStrategy
+ * @brief Estrategia que usa generic_sort_adaptive tras muestrear la entrada.
+ */
+typedef enum SortStrategy {
+    SORT_STRATEGY_NONE,      /**< No había nada que ordenar. */
+    SORT_STRATEGY_QUICKSORT, /**< pdqsort con partición por bloques. */
+    SORT_STRATEGY_THREE_WAY, /**< Quicksort con partición a tres vías: muchas claves repetidas. */
+    SORT_STRATEGY_RUNS       /**< Tramos, inversión y fusión: entrada casi ordenada o inversa. */
+} SortStrategy;
+
+/**
+ * @def SORT_ADAPTIVE_MIN
+ * @brief Número de elementos a partir del cual generic_sort muestrea la
+ *        entrada para elegir estrategia; por debajo usa siempre pdqsort.
+ */
+#ifndef SORT_ADAPTIVE_MIN
+#define SORT_ADAPTIVE_MIN 1024
+#endif
+
+SortStrategy generic_sort_adaptive(Iterator *it, CompareFunc compare);
+
+const char *sort_strategy_name(SortStrategy strategy);
+
+void generic_nth_element(Iterator *it, size_t nth, CompareFunc compare);
+
+void generic_partial_sort(Iterator *it, size_t k, CompareFunc compare);
+
+size_t generic_top_k(Iterator *it, size_t k, CompareFunc compare, void **out);
+
+/**
+ * @struct SortedIterator
+ * @brief Iterador que entrega en orden los elementos de otro, ordenando solo lo que se consume.
+ *
+ * La primera llamada a next materializa la fuente en una tabla de punteros;
+ * a partir de ahí cada elemento se obtiene con quicksort incremental: se
+ * parte solo el tramo que contiene la siguiente posición y los pivotes
+ * pendientes se guardan en una pila. Consumir k elementos cuesta O(n + k log k).
+ */
+typedef struct SortedIterator {
+    Iterator source;      /**< Iterador fuente (se destruye con este). */
+    CompareFunc compare;  /**< Función de comparación. */
+    void **elements;      /**< Elementos de la fuente, NULL hasta la primera llamada. */
+    size_t size;          /**< Número de elementos. */
+    size_t index;         /**< Siguiente posición a entregar. */
+    size_t sorted_end;    /**< Las posiciones anteriores ya están en su sitio definitivo. */
+    size_t *pivots;       /**< Pila de posiciones de pivote pendientes (la cima es la menor). */
+    size_t pivot_count;   /**< Elementos en la pila. */
+    size_t pivot_capacity;/**< Capacidad de la pila. */
+    int bad_allowed;      /**< Particiones desequilibradas toleradas antes de ordenar el tramo entero. */
+} SortedIterator;
+
+Iterator sorted_iterator(Iterator src, CompareFunc compare);
+
+/**
+ * @struct MergeIterator
+ * @brief Iterador que fusiona k iteradores ya ordenados en un único flujo ordenado.
+ *
+ * Usa un árbol de perdedores (torneo): cada nodo interno guarda la fuente que
+ * perdió allí y la raíz la ganadora. Al avanzar solo se rejuega el camino de
+ * la hoja ganadora, unas log2(k) comparaciones por elemento. Cada fuente se
+ * lee por lotes de ITERATOR_BATCH_SIZE elementos.
+ */
+typedef struct MergeIterator {
+    Iterator *sources;   /**< Iteradores fuente (se destruyen con este). */
+    size_t count;        /**< Número de fuentes. */
+    CompareFunc compare; /**< Función de comparación. */
+    void **buffers;      /**< Lote en curso de cada fuente (ITERATOR_BATCH_SIZE por fuente). */
+    size_t *positions;   /**< Posición del elemento de cabeza en el lote de cada fuente. */
+    size_t *lengths;     /**< Elementos del lote de cada fuente (0 = fuente agotada). */
+    size_t *tree;        /**< tree[0] es la fuente ganadora; tree[1..count) las perdedoras. */
+    bool started;        /**< Si ya se leyó el primer lote de las fuentes y se jugó el torneo. */
+    bool pending;        /**< Si hay que avanzar la ganadora antes de entregar otro elemento. */
+} MergeIterator;
+
+Iterator merge_iterators(Iterator *sources, size_t k, CompareFunc compare);
+
+void generic_sort_inplace(Iterator *it, CompareFunc compare);
+
+void generic_sort_records(void *base, size_t count, size_t element_size, CompareFunc compare);
+
+/**
+ * @typedef RadixKeyFunc
+ * @brief Función que extrae los bits de la clave de radix sort de un elemento
+ * @param element Puntero al elemento
+ * @return Bits de la clave, interpretados según RadixKey::width y RadixKey::type
+ */
+typedef uint64_t (*RadixKeyFunc)(const void *element);
+
+/**
+ * @enum RadixKeyType
+ * @brief Interpretación de los bits de la clave de radix sort.
+ */
+typedef enum RadixKeyType {
+    RADIX_KEY_UNSIGNED, /**< Entero sin signo. */
+    RADIX_KEY_SIGNED,   /**< Entero con signo en complemento a dos. */
+    RADIX_KEY_FLOAT     /**< Flotante IEEE 754 (width 4 = float, 8 = double). */
+} RadixKeyType;
+
+/**
+ * @struct RadixKey
+ * @brief Descripción de la clave de ordenación para radix sort.
+ *
+ * La clave se lee con `key_fn` si no es NULL, o directamente de `width` bytes
+ * en `offset` dentro de cada elemento (en el orden de bytes de la máquina).
+ */
+typedef struct RadixKey {
+    RadixKeyFunc key_fn; /**< Extractor de clave opcional. */
+    size_t offset;       /**< Desplazamiento de la clave dentro del elemento (si key_fn es NULL). */
+    size_t width;        /**< Anchura de la clave en bytes: 1, 2, 4 u 8. */
+    RadixKeyType type;   /**< Interpretación de los bits de la clave. */
+} RadixKey;
+
+bool radix_key_valid(const RadixKey *key);
+
+uint64_t radix_key_value(const void *element, const RadixKey *key);
+
+uint64_t radix_key_normalize(uint64_t raw, const RadixKey *key);
+
+/**
+ * @def PARALLEL_SORT_THRESHOLD
+ * @brief Número de elementos por debajo del cual la ordenación paralela usa
+ *        el camino secuencial (ajustable con generic_parallel_sort_set_threshold).
+ */
+#ifndef PARALLEL_SORT_THRESHOLD
+#define PARALLEL_SORT_THRESHOLD 100000
+#endif
+
+void generic_parallel_sort_set_threshold(size_t min_elements);
+
+void generic_parallel_sort(Iterator *it, CompareFunc compare, size_t threads);
+
+void generic_parallel_sort_records(void *base, size_t count, size_t element_size,
+                                   CompareFunc compare, size_t threads);
+
+size_t generic_stable_sort_scratch_size(size_t count, size_t element_size);
+
+bool generic_stable_sort(Iterator *it, CompareFunc compare, void *scratch, size_t scratch_size);
+
+bool generic_stable_sort_records(void *base, size_t count, size_t element_size,
+                                 CompareFunc compare, void *scratch, size_t scratch_size);
+
+bool generic_argsort(const Iterator *it, CompareFunc compare, size_t *perm);
+
+bool generic_stable_argsort(const Iterator *it, CompareFunc compare, size_t *perm);
+
+bool generic_parallel_argsort(const Iterator *it, CompareFunc compare, size_t *perm, size_t threads);
+
+bool apply_permutation(void *base, size_t count, size_t element_size, size_t *perm);
+
+bool generic_sort_zip(Iterator *it, const size_t *keys, size_t key_count, CompareFunc compare);
+
+bool generic_radix_sort(Iterator *it, const RadixKey *key);
+
+bool generic_radix_sort_records(void *base, size_t count, size_t element_size, const RadixKey *key);
+
+uint64_t string_key_prefix(const void *element);
+
+bool generic_sort_cached(Iterator *it, const RadixKey *key, CompareFunc compare);
+
+/*
+ * Ordenaciones sin comparador para tipos primitivos. generic_sort_<tipo>
+ * ordena la vista de un GenericArrayIterator igual que generic_sort;
+ * generic_sort_<tipo>_array ordena directamente un array del tipo.
+ * Los NaN de float/double quedan al final; str ordena como strcmp, con
+ * multikey quicksort sobre los caracteres.
+ */
+void generic_sort_int32(Iterator *it);
+void generic_sort_int64(Iterator *it);
+void generic_sort_uint32(Iterator *it);
+void generic_sort_uint64(Iterator *it);
+void generic_sort_float(Iterator *it);
+void generic_sort_double(Iterator *it);
+void generic_sort_str(Iterator *it);
+
+void generic_sort_int32_array(int32_t *array, size_t count);
+void generic_sort_int64_array(int64_t *array, size_t count);
+void generic_sort_uint32_array(uint32_t *array, size_t count);
+void generic_sort_uint64_array(uint64_t *array, size_t count);
+void generic_sort_float_array(float *array, size_t count);
+void generic_sort_double_array(double *array, size_t count);
+void generic_sort_str_array(const char **array, size_t count);
+
 #endif
\ No newline at end of file
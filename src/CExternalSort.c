@@ -0,0 +1,727 @@
+/**
+ * @file CExternalSort.c
+ * @brief Implementación de la ordenación externa de registros de tamaño fijo
+ *
+ * Fase 1: se llena un bloque de `memory_budget` bytes con registros de la
+ * entrada, se ordena en memoria y se añade como tramo a un fichero temporal
+ * (tmpfile()) que guarda todos los tramos seguidos.
+ * Fase 2: los tramos se fusionan con un heap de k vías; cada tramo se lee con
+ * un buffer propio y la salida usa otro, todos repartidos del presupuesto. Si
+ * hay más tramos de los que caben con bloques de EXTERNAL_SORT_MIN_BLOCK, se
+ * fusionan por grupos en tramos mayores, en un fichero nuevo por pasada,
+ * hasta que caben.
+ *
+ * Si toda la entrada cabe en un bloque no se crea ningún fichero temporal.
+ */
+
+#ifndef CEXTERNALSORT_C
+#define CEXTERNALSORT_C
+
+#include "CExternalSort.h"
+
+#include <errno.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @struct ExternalSource
+ * @brief Entrada de la ordenación: un descriptor o una región en memoria (p. ej. mmap).
+ */
+typedef struct ExternalSource {
+    int fd;           /**< Descriptor de lectura (-1 si la entrada es una región). */
+    const char *data; /**< Región de entrada (NULL si la entrada es un descriptor). */
+    size_t size;      /**< Tamaño de la región en bytes. */
+    size_t offset;    /**< Bytes de la región ya consumidos. */
+} ExternalSource;
+
+#if defined(_WIN32)
+#define external_seek(file, offset) _fseeki64((file), (offset), SEEK_SET)
+#else
+#define external_seek(file, offset) fseeko((file), (off_t)(offset), SEEK_SET)
+#endif
+
+/**
+ * @struct ExternalSpan
+ * @brief Posición de un tramo ordenado dentro del fichero temporal.
+ */
+typedef struct ExternalSpan {
+    int64_t offset; /**< Primer byte del tramo. */
+    int64_t length; /**< Bytes del tramo. */
+} ExternalSpan;
+
+/**
+ * @struct ExternalStore
+ * @brief Fichero temporal con los tramos de una pasada, uno detrás de otro.
+ *
+ * Todos los tramos de una pasada comparten fichero, así que el número de
+ * descriptores abiertos no depende del número de tramos.
+ */
+typedef struct ExternalStore {
+    FILE *file;          /**< Fichero de tmpfile(), se borra al cerrarse. */
+    ExternalSpan *spans; /**< Tramos, en el orden en que se escribieron. */
+    size_t count;        /**< Número de tramos. */
+    size_t allocated;    /**< Capacidad de spans. */
+    int64_t size;        /**< Bytes escritos en el fichero. */
+} ExternalStore;
+
+/**
+ * @struct ExternalRun
+ * @brief Tramo ordenado que se lee durante la fusión.
+ */
+typedef struct ExternalRun {
+    int64_t next; /**< Siguiente byte del tramo por leer del fichero. */
+    int64_t end;  /**< Fin del tramo en el fichero. */
+    char *buffer; /**< Bloque con los registros leídos. */
+    size_t len;   /**< Bytes válidos en buffer. */
+    size_t pos;   /**< Bytes de buffer ya consumidos. */
+} ExternalRun;
+
+/**
+ * @struct ExternalMerge
+ * @brief Fusión de k vías por extracción: cada llamada a external_merge_next
+ *        devuelve el siguiente registro en orden.
+ */
+typedef struct ExternalMerge {
+    FILE *file;          /**< Fichero de los tramos (NULL si el único tramo está en memoria). */
+    ExternalRun *runs;   /**< Tramos que se fusionan. */
+    size_t count;        /**< Número de tramos. */
+    size_t *heap;        /**< Heap mínimo de índices de tramo, por su registro actual. */
+    size_t heap_size;    /**< Tramos con registros pendientes. */
+    size_t block;        /**< Tamaño de los bloques de lectura en bytes. */
+    char *memory;        /**< Memoria de todos los bloques de lectura. */
+    size_t element_size; /**< Tamaño de cada registro. */
+    CompareFunc compare; /**< Función de comparación. */
+    bool pending;        /**< El registro devuelto por última vez aún no se ha consumido. */
+    bool failed;         /**< Error de lectura en algún tramo. */
+} ExternalMerge;
+
+/**
+ * @struct ExternalSortIterator
+ * @brief Implementación del iterador devuelto por external_sort_iterator.
+ */
+typedef struct ExternalSortIterator {
+    ExternalStore store; /**< Tramos de la fusión final. */
+    ExternalMerge merge; /**< Fusión final de los tramos. */
+    char *chunk;         /**< Bloque en memoria si la entrada cabía en uno solo. */
+} ExternalSortIterator;
+
+static void external_store_close(ExternalStore *store)
+{
+    if (store->file)
+        fclose(store->file);
+    free(store->spans);
+    *store = (ExternalStore){0};
+}
+
+/**
+ * @brief Añade un tramo de `length` bytes ya escrito al final del fichero.
+ */
+static bool external_store_add(ExternalStore *store, int64_t length)
+{
+    if (store->count == store->allocated)
+    {
+        size_t grown = store->allocated ? store->allocated * 2 : 16;
+        ExternalSpan *tmp = realloc(store->spans, grown * sizeof(ExternalSpan));
+        if (!tmp)
+            return false;
+        store->spans = tmp;
+        store->allocated = grown;
+    }
+    store->spans[store->count++] = (ExternalSpan){ .offset = store->size, .length = length };
+    store->size += length;
+    return true;
+}
+
+/**
+ * @brief Lee hasta `capacity` bytes de la entrada.
+ * @return false si hubo un error de lectura.
+ */
+static bool external_read(ExternalSource *src, char *buffer, size_t capacity, size_t *got)
+{
+    *got = 0;
+
+    if (src->data)
+    {
+        size_t n = src->size - src->offset;
+        if (n > capacity)
+            n = capacity;
+        memcpy(buffer, src->data + src->offset, n);
+        src->offset += n;
+        *got = n;
+        return true;
+    }
+
+    while (*got < capacity)
+    {
+        ssize_t n = read(src->fd, buffer + *got, capacity - *got);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return false;
+        if (n == 0)
+            break;
+        *got += (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe `len` bytes en un descriptor, reintentando las escrituras parciales.
+ */
+static bool external_write(int fd, const char *buffer, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(fd, buffer, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        buffer += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Fase 1: parte la entrada en tramos ordenados.
+ *
+ * @param store Recibe los tramos (store->count queda a 0 si no hizo falta el disco).
+ * @param chunk_out Si toda la entrada cabe en un bloque, recibe el bloque
+ *                  ordenado; si no, NULL.
+ * @param chunk_len Bytes válidos de *chunk_out.
+ * @return false si hubo un error de lectura, escritura o memoria.
+ */
+static bool external_make_runs(ExternalSource *src, size_t element_size, CompareFunc compare,
+                               size_t budget, ExternalStore *store,
+                               char **chunk_out, size_t *chunk_len)
+{
+    size_t capacity = budget / element_size * element_size;
+    char *chunk = malloc(capacity);
+
+    *store = (ExternalStore){0};
+    *chunk_out = NULL;
+    *chunk_len = 0;
+    if (!chunk)
+        return false;
+
+    for (;;)
+    {
+        size_t got;
+        if (!external_read(src, chunk, capacity, &got) || got % element_size != 0)
+            goto fail;
+
+        generic_sort_records(chunk, got / element_size, element_size, compare);
+
+        // Entrada completa en un único bloque: no hace falta tocar el disco
+        if (store->count == 0 && got < capacity)
+        {
+            *chunk_out = chunk;
+            *chunk_len = got;
+            return true;
+        }
+        if (got == 0)
+            break;
+
+        if (!store->file && !(store->file = tmpfile()))
+            goto fail;
+        if (fwrite(chunk, 1, got, store->file) != got || !external_store_add(store, (int64_t)got))
+            goto fail;
+
+        if (got < capacity)
+            break;
+    }
+
+    free(chunk);
+    if (fflush(store->file) != 0)
+    {
+        external_store_close(store);
+        return false;
+    }
+    return true;
+
+fail:
+    free(chunk);
+    external_store_close(store);
+    return false;
+}
+
+static inline bool external_run_less(const ExternalMerge *m, size_t a, size_t b)
+{
+    const ExternalRun *ra = &m->runs[a];
+    const ExternalRun *rb = &m->runs[b];
+    return m->compare(ra->buffer + ra->pos, rb->buffer + rb->pos) < 0;
+}
+
+static void external_heap_sift_down(ExternalMerge *m, size_t root)
+{
+    size_t *heap = m->heap;
+    size_t child;
+
+    while ((child = 2 * root + 1) < m->heap_size)
+    {
+        if (child + 1 < m->heap_size && external_run_less(m, heap[child + 1], heap[child]))
+            child++;
+        if (!external_run_less(m, heap[child], heap[root]))
+            return;
+        size_t tmp = heap[root];
+        heap[root] = heap[child];
+        heap[child] = tmp;
+        root = child;
+    }
+}
+
+/**
+ * @brief Recarga el bloque de un tramo con su siguiente trozo del fichero.
+ * @return true si quedan registros en el tramo.
+ */
+static bool external_run_fill(ExternalMerge *m, ExternalRun *run)
+{
+    run->pos = 0;
+    run->len = 0;
+    if (!m->file || run->next >= run->end)
+        return false;
+
+    size_t want = m->block;
+    if ((int64_t)want > run->end - run->next)
+        want = (size_t)(run->end - run->next);
+
+    if (external_seek(m->file, run->next) != 0 || fread(run->buffer, 1, want, m->file) != want)
+    {
+        m->failed = true;
+        return false;
+    }
+    run->next += (int64_t)want;
+    run->len = want;
+    return true;
+}
+
+/**
+ * @brief Prepara la fusión de `count` tramos de un fichero, o de un único bloque en memoria.
+ *
+ * Los bloques de lectura se reparten `budget` bytes a partes iguales entre
+ * los tramos y un bloque más para la salida. El fichero no pasa a ser de la
+ * fusión: lo cierra quien lo creó.
+ */
+static bool external_merge_init(ExternalMerge *m, FILE *file, const ExternalSpan *spans, size_t count,
+                                char *chunk, size_t chunk_len,
+                                size_t element_size, CompareFunc compare, size_t budget)
+{
+    size_t runs = chunk ? 1 : count;
+
+    *m = (ExternalMerge){ .file = chunk ? NULL : file, .count = runs,
+                          .element_size = element_size, .compare = compare };
+    m->runs = calloc(runs ? runs : 1, sizeof(ExternalRun));
+    m->heap = malloc((runs ? runs : 1) * sizeof(size_t));
+    if (!m->runs || !m->heap)
+        return false;
+
+    if (chunk)
+    {
+        m->runs[0] = (ExternalRun){ .buffer = chunk, .len = chunk_len };
+        if (chunk_len)
+            m->heap[m->heap_size++] = 0;
+        return true;
+    }
+
+    m->block = budget / (count + 1) / element_size * element_size;
+    if (m->block < element_size)
+        m->block = element_size;
+    m->memory = malloc(count * m->block);
+    if (!m->memory)
+        return false;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m->runs[i] = (ExternalRun){
+            .next = spans[i].offset,
+            .end = spans[i].offset + spans[i].length,
+            .buffer = m->memory + i * m->block
+        };
+        if (external_run_fill(m, &m->runs[i]))
+            m->heap[m->heap_size++] = i;
+    }
+    for (size_t i = m->heap_size / 2; i-- > 0;)
+        external_heap_sift_down(m, i);
+    return !m->failed;
+}
+
+static void external_merge_free(ExternalMerge *m)
+{
+    free(m->runs);
+    free(m->heap);
+    free(m->memory);
+    *m = (ExternalMerge){0};
+}
+
+/**
+ * @brief Siguiente registro de la fusión.
+ * @return Puntero al registro (válido hasta la siguiente llamada), o NULL al terminar.
+ */
+static const char *external_merge_next(ExternalMerge *m)
+{
+    if (m->pending)
+    {
+        // Consumir el registro devuelto en la llamada anterior
+        m->pending = false;
+        ExternalRun *run = &m->runs[m->heap[0]];
+        run->pos += m->element_size;
+        if (run->pos == run->len && !external_run_fill(m, run))
+            m->heap[0] = m->heap[--m->heap_size];
+        if (m->heap_size > 1)
+            external_heap_sift_down(m, 0);
+    }
+
+    if (m->heap_size == 0 || m->failed)
+        return NULL;
+
+    const ExternalRun *run = &m->runs[m->heap[0]];
+    m->pending = true;
+    return run->buffer + run->pos;
+}
+
+/**
+ * @brief Indica si consumir el registro pendiente obliga a releer el bloque de su tramo.
+ */
+static inline bool external_merge_refills(const ExternalMerge *m)
+{
+    if (!m->pending)
+        return false;
+    const ExternalRun *run = &m->runs[m->heap[0]];
+    return run->pos + m->element_size == run->len;
+}
+
+/**
+ * @brief Vuelca todos los registros de la fusión en un fichero o en un descriptor.
+ *
+ * @param file Destino si no es NULL (tramo de una pasada intermedia).
+ * @param fd Destino si file es NULL.
+ * @param written Si no es NULL, recibe los bytes escritos.
+ */
+static bool external_merge_drain(ExternalMerge *m, FILE *file, int fd, int64_t *written)
+{
+    size_t es = m->element_size;
+    size_t capacity = m->block;
+    char *out = malloc(capacity);
+    size_t used = 0;
+    int64_t total = 0;
+    bool ok = out != NULL;
+    const char *record;
+
+    while (ok && (record = external_merge_next(m)))
+    {
+        memcpy(out + used, record, es);
+        used += es;
+        if (used == capacity)
+        {
+            ok = file ? fwrite(out, 1, used, file) == used : external_write(fd, out, used);
+            total += (int64_t)used;
+            used = 0;
+        }
+    }
+    if (ok && used)
+    {
+        ok = file ? fwrite(out, 1, used, file) == used : external_write(fd, out, used);
+        total += (int64_t)used;
+    }
+
+    free(out);
+    if (written)
+        *written = total;
+    return ok && !m->failed;
+}
+
+/**
+ * @brief Número máximo de tramos que se fusionan a la vez con el presupuesto dado.
+ */
+static size_t external_fan_in(size_t budget, size_t element_size)
+{
+    size_t block = EXTERNAL_SORT_MIN_BLOCK > element_size ? EXTERNAL_SORT_MIN_BLOCK : element_size;
+    size_t fan_in = budget / block;
+    return fan_in > 2 ? fan_in - 1 : 2;
+}
+
+/**
+ * @brief Fusiona tramos por grupos, en pasadas sobre ficheros nuevos, hasta
+ *        que quedan como mucho `fan_in`.
+ */
+static bool external_reduce_runs(ExternalStore *store, size_t element_size,
+                                 CompareFunc compare, size_t budget)
+{
+    size_t fan_in = external_fan_in(budget, element_size);
+
+    while (store->count > fan_in)
+    {
+        ExternalStore next = { .file = tmpfile() };
+        if (!next.file)
+            return false;
+
+        for (size_t first = 0; first < store->count; first += fan_in)
+        {
+            size_t group = store->count - first < fan_in ? store->count - first : fan_in;
+            ExternalMerge m;
+            int64_t written = 0;
+
+            bool ok = external_merge_init(&m, store->file, store->spans + first, group,
+                                          NULL, 0, element_size, compare, budget) &&
+                      external_merge_drain(&m, next.file, -1, &written) &&
+                      external_store_add(&next, written);
+            external_merge_free(&m);
+            if (!ok)
+            {
+                external_store_close(&next);
+                return false;
+            }
+        }
+
+        if (fflush(next.file) != 0)
+        {
+            external_store_close(&next);
+            return false;
+        }
+        external_store_close(store);
+        *store = next;
+    }
+    return true;
+}
+
+/**
+ * @brief Ordena la entrada y prepara la fusión final.
+ *
+ * Si devuelve true, el llamador debe liberar store, merge y *chunk.
+ */
+static bool external_prepare(ExternalSource *src, size_t element_size, CompareFunc compare,
+                             size_t budget, ExternalStore *store, ExternalMerge *m, char **chunk)
+{
+    size_t chunk_len;
+
+    if (element_size == 0 || !compare)
+        return false;
+    // Como mínimo: dos bloques de lectura y uno de salida de un registro
+    if (budget < 3 * element_size)
+        budget = 3 * element_size;
+
+    if (!external_make_runs(src, element_size, compare, budget, store, chunk, &chunk_len))
+        return false;
+
+    if (!*chunk && !external_reduce_runs(store, element_size, compare, budget))
+    {
+        external_store_close(store);
+        return false;
+    }
+
+    if (!external_merge_init(m, store->file, store->spans, store->count, *chunk, chunk_len,
+                             element_size, compare, budget))
+    {
+        external_merge_free(m);
+        external_store_close(store);
+        free(*chunk);
+        *chunk = NULL;
+        return false;
+    }
+    return true;
+}
+
+static bool external_sort_to_fd(ExternalSource *src, int out_fd, size_t element_size,
+                                CompareFunc compare, size_t budget)
+{
+    ExternalStore store;
+    ExternalMerge m;
+    char *chunk = NULL;
+
+    if (!external_prepare(src, element_size, compare, budget, &store, &m, &chunk))
+        return false;
+
+    bool ok;
+    if (chunk)
+        ok = external_write(out_fd, chunk, m.runs[0].len);
+    else
+        ok = external_merge_drain(&m, NULL, out_fd, NULL);
+
+    external_merge_free(&m);
+    external_store_close(&store);
+    free(chunk);
+    return ok;
+}
+
+/**
+ * @brief Ordena los registros leídos de un descriptor y los escribe en otro
+ * @param in_fd Descriptor de entrada, se lee secuencialmente hasta EOF
+ * @param out_fd Descriptor de salida, se escribe secuencialmente
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ * @param memory_budget Memoria máxima aproximada para los buffers, en bytes
+ * @return false si hubo un error de E/S o de memoria, o si la entrada no es
+ *         un múltiplo de element_size (la salida puede quedar incompleta)
+ *
+ * Los tramos intermedios se guardan en ficheros de tmpfile(), que desaparecen
+ * al cerrarse.
+ */
+bool generic_external_sort(int in_fd, int out_fd, size_t element_size,
+                           CompareFunc compare, size_t memory_budget)
+{
+    ExternalSource src = { .fd = in_fd, .data = NULL };
+    return external_sort_to_fd(&src, out_fd, element_size, compare, memory_budget);
+}
+
+/**
+ * @brief Ordena los registros de una región en memoria (p. ej. un fichero mapeado con mmap)
+ * @param data Primer byte de la región (no se modifica)
+ * @param size Tamaño de la región en bytes, múltiplo de element_size
+ * @param out_fd Descriptor de salida, se escribe secuencialmente
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ * @param memory_budget Memoria máxima aproximada para los buffers, en bytes
+ * @return false si hubo un error de E/S o de memoria
+ *
+ * La región se recorre una sola vez de principio a fin, así que con un mapeo
+ * las páginas se leen en orden y se pueden descartar tras copiar cada bloque.
+ */
+bool generic_external_sort_region(const void *data, size_t size, int out_fd, size_t element_size,
+                                  CompareFunc compare, size_t memory_budget)
+{
+    if (!data && size)
+        return false;
+    ExternalSource src = { .fd = -1, .data = data ? (const char *)data : "", .size = size };
+    return external_sort_to_fd(&src, out_fd, element_size, compare, memory_budget);
+}
+
+/**
+ * @brief Avanza al siguiente registro en orden; deref() lo devuelve y es
+ *        válido hasta la siguiente llamada.
+ * @return El propio iterador, o NULL al terminar.
+ */
+static void *external_iterator_next(Iterator *it)
+{
+    ExternalSortIterator *iter = (ExternalSortIterator *)it->impl;
+    it->current = (void *)external_merge_next(&iter->merge);
+    return it->current ? it : NULL;
+}
+
+/**
+ * @brief Entrega hasta `max` registros en orden de una vez.
+ *
+ * El lote se corta antes de releer el bloque de un tramo, porque eso
+ * sobrescribiría registros ya entregados: todos los punteros del lote son
+ * válidos hasta la siguiente llamada.
+ */
+static size_t external_iterator_next_batch(Iterator *it, void **out, size_t max)
+{
+    ExternalSortIterator *iter = (ExternalSortIterator *)it->impl;
+    size_t n = 0;
+
+    while (n < max)
+    {
+        if (n > 0 && external_merge_refills(&iter->merge))
+            break;
+        const char *record = external_merge_next(&iter->merge);
+        if (!record)
+            break;
+        out[n++] = (void *)record;
+    }
+
+    it->current = n ? out[n - 1] : NULL;
+    return n;
+}
+
+static bool external_iterator_equal(const Iterator *a, const Iterator *b)
+{
+    return a->impl == b->impl && a->current == b->current;
+}
+
+static void *external_iterator_deref(const Iterator *it)
+{
+    return it->current;
+}
+
+/**
+ * @brief Cierra los tramos temporales y libera los buffers.
+ */
+static void external_iterator_destroy(Iterator *it)
+{
+    ExternalSortIterator *iter = (ExternalSortIterator *)it->impl;
+    if (!iter)
+        return;
+    external_merge_free(&iter->merge);
+    external_store_close(&iter->store);
+    free(iter->chunk);
+    free(iter);
+    it->impl = NULL;
+    it->current = NULL;
+}
+
+/** Tabla de operaciones compartida por los iteradores de ordenación externa. */
+static const IteratorOps external_sort_iterator_ops = {
+    .next = external_iterator_next,
+    .equal = external_iterator_equal,
+    .deref = external_iterator_deref,
+    .destroy = external_iterator_destroy,
+    .next_batch = external_iterator_next_batch
+};
+
+static Iterator external_iterator_create(ExternalSource *src, size_t element_size,
+                                         CompareFunc compare, size_t budget)
+{
+    ExternalSortIterator *impl = malloc(sizeof(ExternalSortIterator));
+    if (!impl)
+        return (Iterator){0};
+
+    impl->chunk = NULL;
+    if (!external_prepare(src, element_size, compare, budget, &impl->store, &impl->merge, &impl->chunk))
+    {
+        free(impl);
+        return (Iterator){0};
+    }
+
+    return (Iterator){
+        .ops = &external_sort_iterator_ops,
+        .category = INPUT_ITERATOR,
+        .impl = impl,
+        .current = NULL
+    };
+}
+
+/**
+ * @brief Crea un iterador que entrega en orden los registros leídos de un descriptor
+ * @param in_fd Descriptor de entrada, se lee por completo al crear el iterador
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ * @param memory_budget Memoria máxima aproximada para los buffers, en bytes
+ * @return Iterador de una sola pasada, o un iterador nulo si hubo un error
+ *
+ * La fase de tramos se hace al crear el iterador; la fusión final se hace al
+ * vuelo con cada next(). Cada puntero devuelto (también los de un lote de
+ * iterator_next_batch) es válido hasta la siguiente llamada, así que no tiene
+ * elementos estables: no sirve como fuente de iterator_to_array ni de
+ * sorted_iterator. Si la lectura de un tramo falla, el iterador termina antes de tiempo.
+ */
+Iterator external_sort_iterator(int in_fd, size_t element_size,
+                                CompareFunc compare, size_t memory_budget)
+{
+    ExternalSource src = { .fd = in_fd, .data = NULL };
+    return external_iterator_create(&src, element_size, compare, memory_budget);
+}
+
+/**
+ * @brief Crea un iterador que entrega en orden los registros de una región en memoria
+ * @param data Primer byte de la región (no se modifica)
+ * @param size Tamaño de la región en bytes, múltiplo de element_size
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ * @param memory_budget Memoria máxima aproximada para los buffers, en bytes
+ * @return Iterador de una sola pasada, o un iterador nulo si hubo un error
+ */
+Iterator external_sort_region_iterator(const void *data, size_t size, size_t element_size,
+                                       CompareFunc compare, size_t memory_budget)
+{
+    if (!data && size)
+        return (Iterator){0};
+    ExternalSource src = { .fd = -1, .data = data ? (const char *)data : "", .size = size };
+    return external_iterator_create(&src, element_size, compare, memory_budget);
+}
+
+#endif // CEXTERNALSORT_C
@@ -19,6 +19,18 @@ static void* generic_array_deref(const Iterator* it) {
     return it->current;
 }
 static void *filter_deref(const Iterator *it);
+static size_t filter_next_batch(Iterator *it, void **out, size_t max);
+static bool source_stable_elements(const Iterator *it);
+
+/** Tabla de operaciones compartida por todos los FilterIterator. */
+static const IteratorOps filter_iterator_ops = {
+    .next = filter_next,
+    .equal = filter_equal,
+    .deref = filter_deref,
+    .destroy = filter_destroy,
+    .next_batch = filter_next_batch,
+    .stable_elements = source_stable_elements
+};
 
 
 /**
@@ -30,13 +42,17 @@ static void *filter_deref(const Iterator *it);
 void *generic_array_next(Iterator *it) {
     GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
     if(iter->index == (size_t)-1){
+        if (iter->size == 0) {
+            it->current = NULL;
+            return NULL;
+        }
         iter->index = 0;
-        it->current = iter->elements[iter->index];
+        it->current = generic_array_get(iter, iter->index);
         return it;
     }
     if (iter->index + 1 < iter->size) {
         iter->index++;
-        it->current = iter->elements[iter->index];
+        it->current = generic_array_get(iter, iter->index);
         return it;
     }
     it->current = NULL;
@@ -54,7 +70,7 @@ bool generic_array_equal(const Iterator *a, const Iterator *b)
 {
     const GenericArrayIterator *ia = (GenericArrayIterator *)a->impl;
     const GenericArrayIterator *ib = (GenericArrayIterator *)b->impl;
-    return ia->index == ib->index && ia->elements == ib->elements;
+    return ia->index == ib->index && ia->base == ib->base && ia->elements == ib->elements;
 }
 
 /**
@@ -71,45 +87,198 @@ void generic_array_destroy(Iterator *it)
 }
 
 /**
- * @brief Crea un iterador para un array genérico.
+ * @brief Avanza hasta `max` elementos de un GenericArrayIterator de una vez.
  *
- * @param array Puntero al array original.
- * @param size Número de elementos en el array.
- * @param element_size Tamaño en bytes de cada elemento.
- * @return Un iterador configurado para recorrer el array.
+ * @param it Puntero al iterador genérico.
+ * @param out Buffer donde se escriben los punteros a los elementos.
+ * @param max Capacidad de `out`.
+ * @return Número de elementos escritos (0 si el iterador está agotado).
  */
-Iterator create_generic_array_iterator(void *array, size_t size, size_t element_size) {
-    void **elements = malloc(size * sizeof(void *));
+static size_t generic_array_next_batch(Iterator *it, void **out, size_t max)
+{
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    size_t start = (iter->index == (size_t)-1) ? 0 : iter->index + 1;
+    if (start >= iter->size || max == 0) {
+        it->current = NULL;
+        return 0;
+    }
+
+    size_t n = iter->size - start;
+    if (n > max)
+        n = max;
+
+    if (iter->elements) {
+        for (size_t i = 0; i < n; i++)
+            out[i] = iter->elements[start + i];
+    } else {
+        char *p = iter->base + start * iter->stride;
+        for (size_t i = 0; i < n; i++, p += iter->stride)
+            out[i] = p;
+    }
+
+    iter->index = start + n - 1;
+    it->current = out[n - 1];
+    return n;
+}
+
+/**
+ * @brief Avanza n posiciones un GenericArrayIterator en O(1).
+ *
+ * Equivale a llamar n veces a next(): si el array se agota antes, el iterador
+ * queda sobre el último elemento con `current` a NULL.
+ *
+ * @param it Puntero al iterador genérico.
+ * @param n Número de posiciones a avanzar.
+ * @return true si se pudo avanzar n posiciones, false si el array se agotó antes.
+ */
+static bool generic_array_advance_by(Iterator *it, size_t n)
+{
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    if (n == 0)
+        return true;
+
+    size_t position = iter->index + 1; // Elementos ya recorridos (index -1 => 0)
+    if (n <= iter->size - position) {
+        iter->index = position + n - 1;
+        it->current = generic_array_get(iter, iter->index);
+        return true;
+    }
+
+    if (iter->size > 0)
+        iter->index = iter->size - 1;
+    it->current = NULL;
+    return false;
+}
+
+/**
+ * @brief Número de posiciones que separan dos GenericArrayIterator del mismo array.
+ *
+ * @param a Iterador de origen.
+ * @param b Iterador de destino.
+ * @return Posición de b menos posición de a.
+ */
+static ptrdiff_t generic_array_distance(const Iterator *a, const Iterator *b)
+{
+    const GenericArrayIterator *ia = (GenericArrayIterator *)a->impl;
+    const GenericArrayIterator *ib = (GenericArrayIterator *)b->impl;
+    return (ptrdiff_t)ib->index - (ptrdiff_t)ia->index;
+}
+
+/**
+ * @brief Acceso directo al elemento i de un GenericArrayIterator.
+ *
+ * @param it Puntero al iterador genérico.
+ * @param i Índice desde el inicio del array.
+ * @return Puntero al elemento, o NULL si i está fuera de rango.
+ */
+static void *generic_array_at(Iterator *it, size_t i)
+{
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    return i < iter->size ? generic_array_get(iter, i) : NULL;
+}
+
+/**
+ * @brief Número total de elementos de un GenericArrayIterator.
+ */
+static size_t generic_array_size(const Iterator *it)
+{
+    return ((const GenericArrayIterator *)it->impl)->size;
+}
+
+/**
+ * @brief Los elementos de un GenericArrayIterator son los del propio array.
+ */
+static bool generic_array_stable_elements(const Iterator *it)
+{
+    return it != NULL;
+}
+
+/** Tabla de operaciones compartida por todos los GenericArrayIterator. */
+const IteratorOps generic_array_iterator_ops = {
+    .next = generic_array_next,
+    .equal = generic_array_equal,
+    .deref = generic_array_deref,
+    .destroy = generic_array_destroy,
+    .next_batch = generic_array_next_batch,
+    .stable_elements = generic_array_stable_elements,
+    .advance_by = generic_array_advance_by,
+    .distance = generic_array_distance,
+    .at = generic_array_at,
+    .size = generic_array_size
+};
+
+/**
+ * @brief Construye (si no existe) la tabla de punteros de un GenericArrayIterator.
+ *
+ * La tabla solo es necesaria para operaciones que permutan la vista del array
+ * sin tocar el buffer original, como generic_sort. Una vez creada, el iterador
+ * la usa en lugar de calcular `base + index * stride`.
+ *
+ * @param iter Implementación del iterador.
+ * @return La tabla de punteros, o NULL si no se pudo reservar memoria.
+ */
+void **generic_array_table(GenericArrayIterator *iter)
+{
+    if (iter->elements)
+        return iter->elements;
+
+    void **elements = malloc((iter->size ? iter->size : 1) * sizeof(void *));
     if (!elements)
-        return (Iterator){0};
+        return NULL;
 
-    for (size_t i = 0; i < size; i++) {
-        elements[i] = (char *)array + i * element_size;
+    for (size_t i = 0; i < iter->size; i++) {
+        elements[i] = iter->base + i * iter->stride;
     }
 
+    iter->elements = elements;
+    return elements;
+}
+
+/**
+ * @brief Crea un iterador para un array genérico con paso arbitrario.
+ *
+ * No copia ni indexa el array: la dirección de cada elemento se calcula en
+ * `next()`, por lo que la construcción es O(1) en tiempo y memoria.
+ *
+ * @param array Puntero al primer elemento del array original.
+ * @param size Número de elementos en el array.
+ * @param element_size Tamaño en bytes de cada elemento.
+ * @param stride Distancia en bytes entre elementos consecutivos (>= element_size).
+ * @return Un iterador configurado para recorrer el array.
+ */
+Iterator create_strided_array_iterator(void *array, size_t size, size_t element_size, size_t stride) {
     GenericArrayIterator *impl = malloc(sizeof(GenericArrayIterator));
-    if (!impl) {
-        free(elements);
+    if (!impl)
         return (Iterator){0};
-    }
 
-    impl->elements = elements;
+    impl->elements = NULL;
+    impl->base = (char *)array;
     impl->index = -1;  // Inicializar a -1
     impl->size = size;
     impl->element_size = element_size;
+    impl->stride = stride;
 
     Iterator iter = {
-        .next = generic_array_next,
-        .equal = generic_array_equal,
-        .deref = generic_array_deref,
-        .destroy = generic_array_destroy,
-        .category = FORWARD_ITERATOR,
+        .ops = &generic_array_iterator_ops,
+        .category = RANDOM_ACCESS_ITERATOR,
         .impl = impl,
         .current = NULL  // Inicializar a NULL
     };
     return iter;
 }
 
+/**
+ * @brief Crea un iterador para un array genérico.
+ *
+ * @param array Puntero al array original.
+ * @param size Número de elementos en el array.
+ * @param element_size Tamaño en bytes de cada elemento.
+ * @return Un iterador configurado para recorrer el array.
+ */
+Iterator create_generic_array_iterator(void *array, size_t size, size_t element_size) {
+    return create_strided_array_iterator(array, size, element_size, element_size);
+}
+
 /**
  * @brief Avanza al siguiente número en un RangeIterator.
  *
@@ -161,10 +330,146 @@ static void *range_deref(const Iterator *it)
  */
 static void range_destroy(Iterator *it)
 {
-    free(it->impl);
+    RangeIterator *iter = (RangeIterator *)it->impl;
+    free(iter->slots);
+    free(iter);
     it->impl = NULL;
 }
 
+/**
+ * @brief Genera hasta `max` valores de un RangeIterator de una vez.
+ *
+ * Los valores se escriben en `slots`, que pertenece al iterador y tiene
+ * siempre ITERATOR_BATCH_SIZE huecos (nunca se realoja): los punteros
+ * devueltos son válidos hasta la siguiente llamada sobre el iterador.
+ *
+ * @param it Iterador de rango.
+ * @param out Buffer donde se escriben los punteros a los valores.
+ * @param max Capacidad de `out`.
+ * @return Número de valores generados (0 si el rango se ha completado).
+ */
+static size_t range_next_batch(Iterator *it, void **out, size_t max)
+{
+    RangeIterator *iter = (RangeIterator *)it->impl;
+    long long first = (long long)iter->current + iter->step;
+    long long remaining = 0;
+
+    if (iter->step > 0 && first < iter->end)
+        remaining = ((long long)iter->end - first + iter->step - 1) / iter->step;
+    else if (iter->step < 0 && first > iter->end)
+        remaining = (first - (long long)iter->end - iter->step - 1) / -(long long)iter->step;
+
+    size_t n = (size_t)remaining < max ? (size_t)remaining : max;
+    if (n > ITERATOR_BATCH_SIZE)
+        n = ITERATOR_BATCH_SIZE;
+    if (n == 0)
+        return 0;
+
+    if (!iter->slots) {
+        iter->slots = malloc(ITERATOR_BATCH_SIZE * sizeof(int));
+        if (!iter->slots)
+            return 0;
+        iter->slot_capacity = ITERATOR_BATCH_SIZE;
+    }
+
+    int value = iter->current;
+    for (size_t i = 0; i < n; i++) {
+        value += iter->step;
+        iter->slots[i] = value;
+        out[i] = &iter->slots[i];
+    }
+
+    iter->current = value;
+    it->current = &iter->current;
+    return n;
+}
+
+/**
+ * @brief Número total de valores que genera un RangeIterator.
+ */
+static size_t range_size(const Iterator *it)
+{
+    const RangeIterator *iter = (const RangeIterator *)it->impl;
+    long long span = (long long)iter->end - iter->start;
+
+    if (iter->step > 0 && span > 0)
+        return (size_t)((span + iter->step - 1) / iter->step);
+    if (iter->step < 0 && span < 0)
+        return (size_t)((-span - iter->step - 1) / -(long long)iter->step);
+    return 0;
+}
+
+/**
+ * @brief Número de valores ya generados (0 antes del primer next()).
+ */
+static size_t range_position(const RangeIterator *iter)
+{
+    return (size_t)(((long long)iter->current - iter->start) / iter->step + 1);
+}
+
+/**
+ * @brief Avanza n valores un RangeIterator en O(1).
+ *
+ * @param it Iterador de rango.
+ * @param n Número de valores a saltar.
+ * @return true si se pudo avanzar n valores, false si el rango terminó antes
+ *         (en ese caso el iterador queda sobre el último valor).
+ */
+static bool range_advance_by(Iterator *it, size_t n)
+{
+    RangeIterator *iter = (RangeIterator *)it->impl;
+    if (n == 0)
+        return true;
+
+    size_t total = range_size(it);
+    size_t position = range_position(iter);
+    if (position >= total)
+        return false;
+
+    bool ok = n <= total - position;
+    size_t target = ok ? position + n : total;
+
+    iter->current = (int)((long long)iter->start + (long long)(target - 1) * iter->step);
+    it->current = &iter->current;
+    return ok;
+}
+
+static ptrdiff_t range_distance(const Iterator *a, const Iterator *b)
+{
+    const RangeIterator *ia = (const RangeIterator *)a->impl;
+    const RangeIterator *ib = (const RangeIterator *)b->impl;
+    return (ptrdiff_t)(((long long)ib->current - ia->current) / ia->step);
+}
+
+/**
+ * @brief Valor i-ésimo del rango sin mover el iterador.
+ *
+ * @return Puntero a un valor interno del iterador (válido hasta la siguiente
+ *         llamada a at()), o NULL si i está fuera del rango.
+ */
+static void *range_at(Iterator *it, size_t i)
+{
+    RangeIterator *iter = (RangeIterator *)it->impl;
+    if (i >= range_size(it))
+        return NULL;
+
+    iter->probe = (int)((long long)iter->start + (long long)i * iter->step);
+    return &iter->probe;
+}
+
+/** Tabla de operaciones compartida por todos los RangeIterator. */
+static const IteratorOps range_iterator_ops = {
+    .next = range_next,
+    .equal = range_equal,
+    .deref = range_deref,
+    .destroy = range_destroy,
+    .next_batch = range_next_batch,
+    .advance_by = range_advance_by,
+    .distance = range_distance,
+    .at = range_at,
+    .size = range_size
+};
+
 /**
  * @brief Crea un iterador de rango (tipo range de Python).
  *
@@ -172,6 +477,11 @@ static void range_destroy(Iterator *it)
  * @param end Valor final (no inclusivo).
  * @param step Paso de incremento/decremento.
  * @return Un iterador configurado para generar la secuencia, o un iterador nulo si el paso es 0 o hay error.
+ *
+ * Los valores viven dentro del iterador: el puntero de deref() y los de un
+ * lote de next_batch solo son válidos hasta la siguiente llamada, así que no
+ * sirve como fuente de consumidores que guardan elementos (iterator_to_array,
+ * sorted_iterator, el lado build de hash_join_iterator).
  */
 Iterator create_range_iterator(int start, int end, int step)
 {
@@ -186,13 +496,13 @@ Iterator create_range_iterator(int start, int end, int step)
         .start = start,    // Almacenar valor inicial
         .current = start - step, // Se ajusta para que el primer next() sea correcto
         .end = end,
-        .step = step};
+        .step = step,
+        .probe = 0,
+        .slots = NULL,
+        .slot_capacity = 0};
 
     Iterator iter = {
-        .next = range_next,
-        .equal = range_equal,
-        .deref = range_deref,
-        .destroy = range_destroy,
+        .ops = &range_iterator_ops,
         .category = INPUT_ITERATOR,
         .impl = impl,
         .current = NULL};
@@ -200,6 +510,42 @@ Iterator create_range_iterator(int start, int end, int step)
     return iter;
 }
 
+/**
+ * @brief Forma hasta `max` tuplas seguidas en `tuples` (count punteros por tupla).
+ *
+ * A cada fuente se le pide como mucho un lote, y solo si ya consumió el
+ * anterior (ver IteratorOps). El número de tuplas lo marca la columna con menos
+ * elementos disponibles; lo que sobra en las demás se usa en la siguiente llamada.
+ *
+ * @return Número de tuplas formadas (0 si alguna fuente se agotó).
+ */
+static size_t multi_zip_fill(MultiZipIterator *iter, void **tuples, size_t max) {
+    size_t n = max < ITERATOR_BATCH_SIZE ? max : ITERATOR_BATCH_SIZE;
+
+    if (iter->count == 0)
+        return 0;
+
+    for (size_t c = 0; c < iter->count && n > 0; c++) {
+        if (iter->positions[c] >= iter->lengths[c]) {
+            iter->positions[c] = 0;
+            iter->lengths[c] = iterator_next_batch(&iter->iterators[c],
+                                                   iter->columns + c * ITERATOR_BATCH_SIZE,
+                                                   ITERATOR_BATCH_SIZE);
+        }
+        size_t available = iter->lengths[c] - iter->positions[c];
+        if (available < n)
+            n = available; // Un iterador agotado acorta el lote para todas las columnas
+    }
+
+    for (size_t c = 0; c < iter->count; c++) {
+        void **column = iter->columns + c * ITERATOR_BATCH_SIZE + iter->positions[c];
+        for (size_t i = 0; i < n; i++)
+            tuples[i * iter->count + c] = column[i];
+        iter->positions[c] += n;
+    }
+    return n;
+}
+
 /**
  * @brief Obtiene el siguiente elemento en la secuencia del iterador MultiZip.
  * @param it Puntero al iterador MultiZip.
@@ -207,20 +553,11 @@ Iterator create_range_iterator(int start, int end, int step)
  */
 static void *multi_zip_next(Iterator *it) {
     MultiZipIterator *iter = (MultiZipIterator *)it->impl;
-    bool all_valid = true;
-    void **elements = malloc(iter->count * sizeof(void *));  // Asignar memoria aquí
-
-    for (size_t i = 0; i < iter->count; i++) {
-        if (iter->iterators[i].next(&iter->iterators[i])) {
-            elements[i] = iter->iterators[i].deref(&iter->iterators[i]);
-        } else {
-            all_valid = false;
-            break; // Si un iterador se agota, salir del bucle
-        }
-    }
 
-    if (!all_valid) {
-        free(elements); // Liberar memoria si no todos son válidos
+    // Cada tupla de next() es un bloque propio que el llamador puede conservar o liberar
+    void **elements = malloc((iter->count ? iter->count : 1) * sizeof(void *));
+    if (!elements || multi_zip_fill(iter, elements, 1) == 0) {
+        free(elements);
         it->current = NULL;
         return NULL;
     }
@@ -245,7 +582,7 @@ static bool multi_zip_equal(const Iterator *a, const Iterator *b) {
     }
 
     for (size_t i = 0; i < ia->count; i++) {
-        if (!ia->iterators[i].equal(&ia->iterators[i], &ib->iterators[i])) {
+        if (!iterator_equal(&ia->iterators[i], &ib->iterators[i])) {
             return false;
         }
     }
@@ -269,13 +606,54 @@ static void *multi_zip_deref(const Iterator *it) {
 static void multi_zip_destroy(Iterator *it) {
     MultiZipIterator *iter = (MultiZipIterator *)it->impl;
     for (size_t i = 0; i < iter->count; i++) {
-        iter->iterators[i].destroy(&iter->iterators[i]);
+        iterator_destroy(&iter->iterators[i]);
     }
     free(iter->iterators);
+    free(iter->columns);
+    free(iter->positions);
+    free(iter->lengths);
+    free(iter->tuples);
     free(iter);
     it->impl = NULL;
 }
 
+/**
+ * @brief Obtiene hasta `max` tuplas del iterador MultiZip de una vez.
+ *
+ * Cada tupla es un array `void*[count]` que pertenece al iterador y solo es
+ * válido hasta la siguiente llamada (a diferencia de next(), que devuelve una
+ * copia propia de cada tupla).
+ *
+ * @param it Puntero al iterador MultiZip.
+ * @param out Buffer donde se escriben los punteros a las tuplas.
+ * @param max Capacidad de `out`.
+ * @return Número de tuplas generadas (0 si algún iterador fuente se agotó).
+ */
+static size_t multi_zip_next_batch(Iterator *it, void **out, size_t max) {
+    MultiZipIterator *iter = (MultiZipIterator *)it->impl;
+    size_t n = multi_zip_fill(iter, iter->tuples, max);
+
+    if (n == 0) {
+        it->current = NULL;
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = iter->tuples + i * iter->count;
+
+    it->current = out[n - 1];
+    return n;
+}
+
+/** Tabla de operaciones compartida por todos los MultiZipIterator. */
+static const IteratorOps multi_zip_iterator_ops = {
+    .next = multi_zip_next,
+    .equal = multi_zip_equal,
+    .deref = multi_zip_deref,
+    .destroy = multi_zip_destroy,
+    .next_batch = multi_zip_next_batch
+};
+
 /**
  * @brief Crea un iterador de filtrado que solo incluye los elementos que cumplen una condición.
  * 
@@ -293,10 +671,7 @@ Iterator filter_iterator(Iterator it, bool (*filter_fn)(void *)) {
         .filter_fn = filter_fn};
 
     Iterator iter = {
-        .next = filter_next,
-        .equal = filter_equal,
-        .deref = filter_deref,
-        .destroy = filter_destroy,
+        .ops = &filter_iterator_ops,
         .category = FILTER_ITERATOR, // Corrección
         .impl = impl,
         .current = NULL};
@@ -309,9 +684,9 @@ static void *filter_next(Iterator *it)
 {
     FilterIterator *iter = (FilterIterator *)it->impl;
 
-    while (iter->source.next(&iter->source))
+    while (iterator_next(&iter->source))
     {
-        void *element = iter->source.deref(&iter->source);
+        void *element = iterator_deref(&iter->source);
         if (iter->filter_fn(element))
         {
             it->current = element;
@@ -334,38 +709,38 @@ Iterator multi_zip_iterators(Iterator* iterators, size_t count) {
     if (!impl)
         return (Iterator){0};
 
-    Iterator* owned_iterators = malloc(count * sizeof(Iterator));
-    bool* valid = malloc(count * sizeof(bool));
-    void** elements = malloc(count * sizeof(void*));
+    size_t slots = count ? count : 1;
+    Iterator* owned_iterators = malloc(slots * sizeof(Iterator));
+    void** columns = malloc(slots * ITERATOR_BATCH_SIZE * sizeof(void*));
+    size_t* positions = calloc(slots, sizeof(size_t));
+    size_t* lengths = calloc(slots, sizeof(size_t));
+    void** tuples = malloc(slots * ITERATOR_BATCH_SIZE * sizeof(void*));
 
-    if (!owned_iterators || !valid || !elements) {
+    if (!owned_iterators || !columns || !positions || !lengths || !tuples) {
         free(owned_iterators);
-        free(valid);
-        free(elements);
+        free(columns);
+        free(positions);
+        free(lengths);
+        free(tuples);
         free(impl);
         return (Iterator){0};
     }
 
     for (size_t i = 0; i < count; i++) {
         owned_iterators[i] = iterators[i];
-        valid[i] = true;
-        elements[i] = NULL;
     }
 
-    // Inicializamos la bandera de primera iteración
     *impl = (MultiZipIterator){
         .iterators = owned_iterators,
         .count = count,
-        .valid = valid,
-        .elements = elements,
-        .first = true
+        .columns = columns,
+        .positions = positions,
+        .lengths = lengths,
+        .tuples = tuples
     };
 
     Iterator iter = {
-        .next = multi_zip_next,
-        .equal = multi_zip_equal,
-        .deref = multi_zip_deref,
-        .destroy = multi_zip_destroy,
+        .ops = &multi_zip_iterator_ops,
         .category = ZIP_ITERATOR,
         .impl = impl,
         .current = NULL   // Se inicializa en NULL, ya que se actualizará en next
@@ -379,7 +754,7 @@ static bool filter_equal(const Iterator *a, const Iterator *b)
 {
     const FilterIterator *ia = (FilterIterator *)a->impl;
     const FilterIterator *ib = (FilterIterator *)b->impl;
-    return ia->source.equal(&ia->source, &ib->source);
+    return iterator_equal(&ia->source, &ib->source);
 }
 
 static void *filter_deref(const Iterator *it)
@@ -387,10 +762,39 @@ static void *filter_deref(const Iterator *it)
     return it->current;
 }
 
+/**
+ * @brief Obtiene hasta `max` elementos que cumplen el predicado.
+ *
+ * Pide un único lote a la fuente por cada lote que entrega (salvo que ningún
+ * elemento pase el filtro), de modo que los punteros de la fuente siguen siendo
+ * válidos al devolverlos. Puede devolver menos de `max` sin estar agotado.
+ */
+static size_t filter_next_batch(Iterator *it, void **out, size_t max)
+{
+    FilterIterator *iter = (FilterIterator *)it->impl;
+    size_t n = 0;
+
+    while (n == 0) {
+        size_t got = iterator_next_batch(&iter->source, out, max);
+        if (got == 0) {
+            it->current = NULL;
+            return 0;
+        }
+        for (size_t i = 0; i < got; i++) {
+            void *element = out[i];
+            out[n] = element;
+            n += iter->filter_fn(element) ? 1 : 0;
+        }
+    }
+
+    it->current = out[n - 1];
+    return n;
+}
+
 static void filter_destroy(Iterator *it)
 {
     FilterIterator *iter = (FilterIterator *)it->impl;
-    iter->source.destroy(&iter->source);
+    iterator_destroy(&iter->source);
     free(iter);
     it->impl = NULL;
 }
@@ -399,8 +803,8 @@ static void filter_destroy(Iterator *it)
 static void *map_next(Iterator *it) {
     MapIterator *iter = (MapIterator *)it->impl;
 
-    if (iter->source.next(&iter->source)) {
-        void *element = iter->source.deref(&iter->source);
+    if (iterator_next(&iter->source)) {
+        void *element = iterator_deref(&iter->source);
         it->current = iter->map_fn(element);
         return it;
     }
@@ -413,7 +817,7 @@ static bool map_equal(const Iterator *a, const Iterator *b)
 {
     const MapIterator *ia = (MapIterator *)a->impl;
     const MapIterator *ib = (MapIterator *)b->impl;
-    return ia->source.equal(&ia->source, &ib->source);
+    return iterator_equal(&ia->source, &ib->source);
 }
 
 static void *map_deref(const Iterator *it)
@@ -424,11 +828,40 @@ static void *map_deref(const Iterator *it)
 static void map_destroy(Iterator *it)
 {
     MapIterator *iter = (MapIterator *)it->impl;
-    iter->source.destroy(&iter->source);
+    iterator_destroy(&iter->source);
     free(iter);
     it->impl = NULL;
 }
 
+/**
+ * @brief Obtiene un lote de la fuente y aplica la función de mapeo sobre él.
+ *
+ * map_fn se llama para todo el lote aunque el consumidor no llegue a verlo
+ * entero; los recorridos que pueden pararse a medias (iterator_find,
+ * iterator_any, iterator_all) usan next() para no hacerlo.
+ */
+static size_t map_next_batch(Iterator *it, void **out, size_t max)
+{
+    MapIterator *iter = (MapIterator *)it->impl;
+    size_t n = iterator_next_batch(&iter->source, out, max);
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = iter->map_fn(out[i]);
+
+    it->current = n ? out[n - 1] : NULL;
+    return n;
+}
+
+/** Tabla de operaciones compartida por todos los MapIterator. */
+static const IteratorOps map_iterator_ops = {
+    .next = map_next,
+    .equal = map_equal,
+    .deref = map_deref,
+    .destroy = map_destroy,
+    .next_batch = map_next_batch,
+    .stable_elements = source_stable_elements
+};
+
 /**
  * @brief Crea un iterador de mapeo que transforma los elementos del iterador fuente.
  * 
@@ -446,10 +879,7 @@ Iterator map_iterator(Iterator it, void *(*map_fn)(void *)) {
         .map_fn = map_fn};
 
     Iterator iter = {
-        .next = map_next,
-        .equal = map_equal,
-        .deref = map_deref,
-        .destroy = map_destroy,
+        .ops = &map_iterator_ops,
         .category = MAP_ITERATOR, // Corrección
         .impl = impl,
         .current = NULL};
@@ -457,8 +887,82 @@ Iterator map_iterator(Iterator it, void *(*map_fn)(void *)) {
     return iter;
 }
 
+/**
+ * @brief Avanza el iterador hasta `max` posiciones y devuelve los elementos recorridos.
+ *
+ * Equivale a llamar `max` veces a next() + deref(), pero amortiza el coste de
+ * la llamada indirecta cuando el iterador implementa next_batch. Si no lo
+ * implementa se usa next()/deref() elemento a elemento.
+ *
+ * Los punteros escritos en `out` tienen la misma validez que los que devolvería
+ * deref(); en iteradores que generan valores (como RangeIterator) solo son
+ * válidos hasta la siguiente llamada sobre el mismo iterador.
+ *
+ * @param it Iterador a avanzar.
+ * @param out Buffer donde se escriben los elementos.
+ * @param max Capacidad de `out`.
+ * @return Número de elementos escritos; 0 solo cuando el iterador se ha agotado.
+ */
+size_t iterator_next_batch(Iterator *it, void **out, size_t max)
+{
+    if (!it || !it->impl || max == 0)
+        return 0;
+
+    if (it->ops->next_batch)
+        return it->ops->next_batch(it, out, max);
+
+    // Si el siguiente next() puede invalidar el elemento actual, solo cabe uno por lote
+    if (!iterator_stable_elements(it))
+        max = 1;
+
+    size_t n = 0;
+    while (n < max && iterator_next(it)) {
+        out[n++] = iterator_deref(it);
+    }
+    return n;
+}
+
+/**
+ * @brief Indica si los elementos de un iterador siguen siendo válidos después de avanzarlo.
+ *
+ * Es cierto para los iteradores sobre memoria del llamador (arrays) y para
+ * los adaptadores cuyas fuentes lo cumplen. Los iteradores que generan o
+ * leen sus elementos en un buffer propio (RangeIterator, la ordenación
+ * externa, las tuplas de MultiZip) solo garantizan cada elemento hasta la
+ * siguiente llamada, o hasta el siguiente lote en next_batch.
+ *
+ * @param it Iterador a consultar.
+ * @return true si se pueden guardar punteros a elementos ya entregados.
+ */
+bool iterator_stable_elements(const Iterator *it)
+{
+    return it && it->impl && it->ops->stable_elements && it->ops->stable_elements(it);
+}
+
+/**
+ * @brief Un FilterIterator o MapIterator entrega elementos tan estables como los de su fuente.
+ */
+static bool source_stable_elements(const Iterator *it)
+{
+    if (it->category == FILTER_ITERATOR)
+        return iterator_stable_elements(&((const FilterIterator *)it->impl)->source);
+    return iterator_stable_elements(&((const MapIterator *)it->impl)->source);
+}
+
+/**
+ * @brief Indica si un consumidor puede recorrer el iterador con iterator_next_batch
+ *        sin que cada lote se quede en un solo elemento.
+ */
+static bool iterator_batches(const Iterator *it)
+{
+    return it->impl && (it->ops->next_batch || iterator_stable_elements(it));
+}
+
 /**
  * @brief Avanza el iterador un número determinado de posiciones.
+ *
+ * Usa el salto O(1) de los iteradores de acceso aleatorio cuando está
+ * disponible y, si no, llama a next() n veces.
  * 
  * @param it Puntero al iterador a avanzar.
  * @param n Número de pasos a avanzar.
@@ -469,9 +973,12 @@ bool iterator_advance(Iterator *it, size_t n)
     if (!it || !it->impl)
         return false;
 
+    if (it->ops->advance_by)
+        return it->ops->advance_by(it, n);
+
     for (size_t i = 0; i < n; i++)
     {
-        if (!it->next(it))
+        if (!iterator_next(it))
         {
             return false;
         }
@@ -479,6 +986,55 @@ bool iterator_advance(Iterator *it, size_t n)
     return true;
 }
 
+/**
+ * @brief Indica si el iterador soporta acceso aleatorio en O(1).
+ * @param it Iterador a consultar.
+ * @return true si implementa advance_by, distance, at y size.
+ */
+bool iterator_is_random_access(const Iterator *it)
+{
+    return it && it->impl && it->ops->advance_by && it->ops->distance &&
+           it->ops->at && it->ops->size;
+}
+
+/**
+ * @brief Calcula cuántas posiciones separan dos iteradores del mismo origen.
+ * @param a Iterador de origen.
+ * @param b Iterador de destino.
+ * @return Posición de b menos posición de a, o 0 si no son de acceso aleatorio.
+ */
+ptrdiff_t iterator_distance(const Iterator *a, const Iterator *b)
+{
+    if (!iterator_is_random_access(a) || !b || a->ops != b->ops)
+        return 0;
+    return a->ops->distance(a, b);
+}
+
+/**
+ * @brief Devuelve el elemento i-ésimo desde el inicio sin mover el iterador.
+ * @param it Iterador de acceso aleatorio.
+ * @param i Índice del elemento.
+ * @return Puntero al elemento, o NULL si está fuera de rango o no hay acceso aleatorio.
+ */
+void *iterator_at(Iterator *it, size_t i)
+{
+    if (!iterator_is_random_access(it))
+        return NULL;
+    return it->ops->at(it, i);
+}
+
+/**
+ * @brief Número total de elementos de un iterador de acceso aleatorio.
+ * @param it Iterador a consultar.
+ * @return Número de elementos, o 0 si el iterador no es de acceso aleatorio.
+ */
+size_t iterator_size(const Iterator *it)
+{
+    if (!iterator_is_random_access(it))
+        return 0;
+    return it->ops->size(it);
+}
+
 /**
  * @brief Reinicia un iterador a su posición inicial
  * @param it Iterador a reiniciar
@@ -498,16 +1054,16 @@ void iterator_reset(Iterator *it) {
         case RANDOM_ACCESS_ITERATOR: {
             GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
             iter->index = 0;
-            it->current = iter->elements[0];  // Apuntar al primer *elemento*
+            it->current = iter->size ? generic_array_get(iter, 0) : NULL;  // Apuntar al primer *elemento*
             break;
         }
         case ZIP_ITERATOR: {
             MultiZipIterator *zip_iter = (MultiZipIterator *)it->impl;
             for (size_t i = 0; i < zip_iter->count; ++i) {
                 iterator_reset(&zip_iter->iterators[i]);
-                zip_iter->valid[i] = true;
+                zip_iter->positions[i] = zip_iter->lengths[i] = 0; // Descartar los lotes pendientes
             }
-            it->next(it); //Avanzar al primer elemento
+            iterator_next(it); //Avanzar al primer elemento
             break;
         }
         case FILTER_ITERATOR: {
@@ -533,29 +1089,41 @@ void iterator_reset(Iterator *it) {
     @return Array dinámico con los elementos del iterador
     El llamador es responsable de liberar la memoria del array devuelto.
 
+    Los punteros guardados solo siguen siendo válidos si el iterador tiene
+    elementos estables (ver iterator_stable_elements); en otro caso cada uno
+    tiene la validez que tenía deref() y varios pueden apuntar al mismo buffer.
     */
 void **iterator_to_array(Iterator it, size_t *count) {
     size_t n = 0;
+    size_t capacity = 0;
     void **array = NULL;
     void **temp_array = NULL;
-    //size_t i = 0;
-
-    // Iterar y copiar los elementos
-    while (it.next(&it)) {
-        void *element = it.deref(&it);
-
-        // Asignar o Reasignar memoria
-        temp_array = realloc(array, (n + 1) * sizeof(void *));
-        if (!temp_array) {
-            // En caso de fallo, liberar la memoria previamente asignada
-            free(array);
-            return NULL;
+    bool stable = iterator_stable_elements(&it);
+
+    // Iterar por lotes, escribiendo directamente en el array de salida
+    for (;;) {
+        // Asignar o Reasignar memoria (crecimiento geométrico)
+        if (capacity - n < ITERATOR_BATCH_SIZE) {
+            size_t new_capacity = capacity ? capacity * 2 : ITERATOR_BATCH_SIZE;
+            temp_array = realloc(array, new_capacity * sizeof(void *));
+            if (!temp_array) {
+                // En caso de fallo, liberar la memoria previamente asignada
+                free(array);
+                return NULL;
+            }
+            array = temp_array; // Actualizar el puntero al nuevo bloque de memoria
+            capacity = new_capacity;
         }
 
-        array = temp_array; // Actualizar el puntero al nuevo bloque de memoria
-
-        // Copiar el elemento
-        array[n++] = element;
+        // Los lotes de un iterador sin elementos estables se invalidan entre sí
+        size_t got = 0;
+        if (stable)
+            got = iterator_next_batch(&it, array + n, capacity - n);
+        else if (iterator_next(&it))
+            array[got++] = iterator_deref(&it);
+        if (got == 0)
+            break;
+        n += got;
     }
 
     // Asignar el tamaño al puntero de conteo (si no es NULL)
@@ -566,15 +1134,81 @@ void **iterator_to_array(Iterator it, size_t *count) {
 }
 
 
+/**
+ * @brief Recorre los elementos restantes de `it` hasta que `visit` devuelva false.
+ *
+ * Un recorrido que puede pararse (`stop_early`) avanza con next() elemento a
+ * elemento: el iterador comparte impl con el del llamador y debe quedar
+ * justo sobre el elemento en que se paró, y una fuente como map_iterator no
+ * debe calcular elementos que nadie va a ver. Un recorrido completo usa lotes
+ * si el iterador los admite.
+ *
+ * @return true si visit devolvió false para algún elemento.
+ */
+static bool iterator_walk(Iterator *it, bool (*visit)(void *, void *), void *ctx, bool stop_early)
+{
+    void *batch[ITERATOR_BATCH_SIZE];
+    size_t got;
+
+    if (stop_early || !iterator_batches(it))
+    {
+        while (iterator_next(it))
+        {
+            if (!visit(iterator_deref(it), ctx))
+                return true;
+        }
+        return false;
+    }
+    while ((got = iterator_next_batch(it, batch, ITERATOR_BATCH_SIZE)) > 0)
+    {
+        for (size_t i = 0; i < got; i++)
+        {
+            if (!visit(batch[i], ctx))
+                return true;
+        }
+    }
+    return false;
+}
+
+typedef struct WalkFind {
+    const void *value;
+    int (*cmp)(const void *, const void *);
+    void *found;
+} WalkFind;
+
+static bool walk_foreach(void *element, void *ctx)
+{
+    (*(void (**)(void *))ctx)(element);
+    return true;
+}
+
+static bool walk_find(void *element, void *ctx)
+{
+    WalkFind *find = (WalkFind *)ctx;
+    if (find->cmp(element, find->value) != 0)
+        return true;
+    find->found = element;
+    return false;
+}
+
+static bool walk_any(void *element, void *ctx)
+{
+    return !(*(bool (**)(void *))ctx)(element);
+}
+
+static bool walk_all(void *element, void *ctx)
+{
+    return (*(bool (**)(void *))ctx)(element);
+}
+
 /**
     @brief Aplica una función a cada elemento del iterador
     @param it Iterador a procesar
     @param func Función a aplicar a cada elemento
     */
 void iterator_foreach(Iterator it, void(func)(void *)) {
-    while (it.next(&it)) {
-        func(it.deref(&it));
-    }
+    void (*fn)(void *) = func;
+    iterator_walk(&it, walk_foreach, &fn, false);
 }
 
 /**
@@ -584,18 +1218,14 @@ void iterator_foreach(Iterator it, void(func)(void *)) {
     @param value Valor a buscar.
     @param cmp Función de comparación que retorna 0 si los elementos son iguales.
     @return Puntero al elemento encontrado o NULL si no se encuentra.
+
+    El iterador queda justo sobre el elemento encontrado.
     */
 void* iterator_find(Iterator it, const void *value, int(cmp)(const void *, const void *))
 {
-    while (it.next(&it))
-    {
-        void *current = it.deref(&it);
-        if (cmp(current, value) == 0)
-        {
-            return current;
-        }
-    }
-    return NULL;
+    WalkFind find = { value, cmp, NULL };
+    iterator_walk(&it, walk_find, &find, true);
+    return find.found;
 }
 
 /**
@@ -606,14 +1236,8 @@ void* iterator_find(Iterator it, const void *value, int(cmp)(const void *, const
 */
 bool iterator_any(Iterator it, bool(pred)(void *))
 {
-    while (it.next(&it))
-    {
-        if (pred(it.deref(&it)))
-        {
-            return true;
-        }
-    }
-    return false;
+    bool (*fn)(void *) = pred;
+    return iterator_walk(&it, walk_any, &fn, true);
 }
 
 /**
@@ -624,14 +1248,8 @@ bool iterator_any(Iterator it, bool(pred)(void *))
 */
 bool iterator_all(Iterator it, bool(pred)(void *))
 {
-    while (it.next(&it))
-    {
-        if (!pred(it.deref(&it)))
-        {
-            return false;
-        }
-    }
-    return true;
+    bool (*fn)(void *) = pred;
+    return !iterator_walk(&it, walk_all, &fn, true);
 }
 
 /**
@@ -0,0 +1,315 @@
+/**
+ * @file CJoin.c
+ * @brief Implementación del hash join entre dos iteradores
+ *
+ * Construcción: el lado de la tabla se copia con iterator_to_array y se
+ * inserta por lotes de ITERATOR_BATCH_SIZE elementos; primero se calculan las
+ * claves y hashes del lote y se precargan sus huecos, y después se insertan,
+ * de modo que los fallos de caché de un lote se solapan.
+ * Sondeo: el lado recorrido se lee con iterator_next_batch y cada lote se
+ * prepara igual antes de buscar sus elementos en la tabla.
+ */
+
+#ifndef CJOIN_C
+#define CJOIN_C
+
+#include "CJoin.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define join_prefetch(p) __builtin_prefetch((p))
+#else
+#define join_prefetch(p) ((void)(p))
+#endif
+
+static inline const void *join_key(const HashJoinIterator *iter, const void *element)
+{
+    return iter->key_fn ? iter->key_fn(element) : element;
+}
+
+/**
+ * @brief Calcula claves y hashes de `count` elementos y precarga sus huecos.
+ */
+static void join_prepare(const HashJoinIterator *iter, void **elements, size_t count,
+                         const void **keys, uint64_t *hashes)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        keys[i] = join_key(iter, elements[i]);
+        hashes[i] = iter->hash_fn(keys[i]);
+        join_prefetch(&iter->table[hashes[i] & iter->mask]);
+    }
+}
+
+/**
+ * @brief Materializa el lado de la tabla y construye la tabla hash.
+ * @return false si no hubo memoria.
+ */
+static bool join_build(HashJoinIterator *iter)
+{
+    size_t n;
+    void **elements = iterator_to_array(iter->swapped ? iter->probe : iter->build, &n);
+    if (!elements)
+        return false;
+
+    // Carga máxima 1/2: siempre queda algún hueco libre que corta el sondeo
+    size_t capacity = 1;
+    while (capacity < 2 * n)
+        capacity *= 2;
+
+    iter->table = calloc(capacity, sizeof(JoinEntry));
+    if (!iter->table)
+    {
+        free(elements);
+        return false;
+    }
+    iter->mask = capacity - 1;
+
+    const void *keys[ITERATOR_BATCH_SIZE];
+    uint64_t hashes[ITERATOR_BATCH_SIZE];
+    for (size_t i = 0; i < n; i += ITERATOR_BATCH_SIZE)
+    {
+        size_t count = n - i < ITERATOR_BATCH_SIZE ? n - i : ITERATOR_BATCH_SIZE;
+        join_prepare(iter, elements + i, count, keys, hashes);
+
+        for (size_t j = 0; j < count; j++)
+        {
+            size_t slot = hashes[j] & iter->mask;
+            while (iter->table[slot].element)
+                slot = (slot + 1) & iter->mask;
+            iter->table[slot] = (JoinEntry){ .hash = hashes[j], .key = keys[j], .element = elements[i + j] };
+        }
+    }
+
+    free(elements);
+    return true;
+}
+
+/**
+ * @brief Lee el siguiente lote del lado recorrido y lo prepara para buscarlo en la tabla.
+ */
+static void join_read_batch(HashJoinIterator *iter)
+{
+    Iterator *side = iter->swapped ? &iter->build : &iter->probe;
+
+    iter->batch_pos = 0;
+    iter->batch_len = iterator_next_batch(side, iter->batch, ITERATOR_BATCH_SIZE);
+    iter->exhausted = iter->batch_len == 0;
+
+    join_prepare(iter, iter->batch, iter->batch_len, iter->keys, iter->hashes);
+    if (iter->batch_len)
+        iter->slot = iter->hashes[0] & iter->mask;
+}
+
+/**
+ * @brief Pasa al siguiente elemento del lote.
+ */
+static inline void join_advance(HashJoinIterator *iter)
+{
+    if (++iter->batch_pos < iter->batch_len)
+        iter->slot = iter->hashes[iter->batch_pos] & iter->mask;
+}
+
+/**
+ * @brief Indica si el elemento en curso del lote tiene alguna coincidencia en la tabla.
+ */
+static bool join_contains(const HashJoinIterator *iter)
+{
+    uint64_t hash = iter->hashes[iter->batch_pos];
+    const void *key = iter->keys[iter->batch_pos];
+
+    for (size_t slot = hash & iter->mask; iter->table[slot].element; slot = (slot + 1) & iter->mask)
+    {
+        const JoinEntry *entry = &iter->table[slot];
+        if (entry->hash == hash && iter->eq_fn(entry->key, key))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Calcula hasta `max` resultados más del join.
+ *
+ * El lote se corta antes de leer otro lote del lado recorrido (ver IteratorOps).
+ */
+static size_t join_fill(HashJoinIterator *iter, void **out, size_t max)
+{
+    size_t n = 0;
+
+    while (n < max)
+    {
+        if (iter->batch_pos >= iter->batch_len)
+        {
+            if (n > 0 || iter->exhausted)
+                break;
+            join_read_batch(iter);
+            if (iter->exhausted)
+                break;
+        }
+
+        void *element = iter->batch[iter->batch_pos];
+
+        if (iter->mode != JOIN_INNER)
+        {
+            if (join_contains(iter) == (iter->mode == JOIN_LEFT_SEMI))
+                out[n++] = element;
+            join_advance(iter);
+            continue;
+        }
+
+        // Se sigue el sondeo donde se dejó: un elemento puede tener varias parejas
+        uint64_t hash = iter->hashes[iter->batch_pos];
+        const void *key = iter->keys[iter->batch_pos];
+        while (n < max && iter->table[iter->slot].element)
+        {
+            const JoinEntry *entry = &iter->table[iter->slot];
+            iter->slot = (iter->slot + 1) & iter->mask;
+            if (entry->hash != hash || !iter->eq_fn(entry->key, key))
+                continue;
+
+            void **tuple = iter->tuples[n];
+            tuple[0] = iter->swapped ? element : entry->element;
+            tuple[1] = iter->swapped ? entry->element : element;
+            out[n++] = tuple;
+        }
+        if (!iter->table[iter->slot].element)
+            join_advance(iter);
+    }
+    return n;
+}
+
+static void *join_next(Iterator *it)
+{
+    void *result;
+
+    if (!join_fill((HashJoinIterator *)it->impl, &result, 1))
+    {
+        it->current = NULL;
+        return NULL;
+    }
+
+    it->current = result;
+    return it;
+}
+
+static size_t join_next_batch(Iterator *it, void **out, size_t max)
+{
+    HashJoinIterator *iter = (HashJoinIterator *)it->impl;
+
+    // Las tuplas de JOIN_INNER salen del buffer del iterador
+    if (iter->mode == JOIN_INNER && max > ITERATOR_BATCH_SIZE)
+        max = ITERATOR_BATCH_SIZE;
+
+    size_t n = join_fill(iter, out, max);
+    it->current = n ? out[n - 1] : NULL;
+    return n;
+}
+
+static bool join_equal(const Iterator *a, const Iterator *b)
+{
+    return a->impl == b->impl && a->current == b->current;
+}
+
+static void *join_deref(const Iterator *it)
+{
+    return it->current;
+}
+
+/**
+ * @brief Las tuplas de JOIN_INNER son del iterador; en los demás modos se
+ *        entregan elementos de probe, tan estables como los de su fuente.
+ */
+static bool join_stable_elements(const Iterator *it)
+{
+    const HashJoinIterator *iter = (const HashJoinIterator *)it->impl;
+    return iter->mode != JOIN_INNER && iterator_stable_elements(&iter->probe);
+}
+
+static void join_destroy(Iterator *it)
+{
+    HashJoinIterator *iter = (HashJoinIterator *)it->impl;
+    iterator_destroy(&iter->build);
+    iterator_destroy(&iter->probe);
+    free(iter->table);
+    free(iter);
+    it->impl = NULL;
+}
+
+/** Tabla de operaciones compartida por todos los HashJoinIterator. */
+static const IteratorOps hash_join_iterator_ops = {
+    .next = join_next,
+    .equal = join_equal,
+    .deref = join_deref,
+    .destroy = join_destroy,
+    .next_batch = join_next_batch,
+    .stable_elements = join_stable_elements
+};
+
+/**
+ * @brief Crea un hash join con el modo indicado
+ * @param build Lado que se materializa en la tabla hash; pasa a ser propiedad del nuevo iterador
+ * @param probe Lado que se recorre; pasa a ser propiedad del nuevo iterador
+ * @param mode Resultado a entregar (ver JoinMode)
+ * @param key_fn Extractor de la clave de cada elemento, o NULL si el elemento es la clave
+ * @param hash_fn Función hash de las claves
+ * @param eq_fn Igualdad de claves
+ * @return Iterador de una sola pasada, o un iterador nulo si falta hash_fn o
+ *         eq_fn, build no tiene elementos estables o no hay memoria (en ese
+ *         caso las entradas siguen siendo del llamador, aunque el lado de la
+ *         tabla puede haberse consumido ya)
+ *
+ * La tabla se construye aquí mismo con el lado materializado. Con JOIN_INNER
+ * cada resultado es una tupla `void*[2]` {elemento de build, elemento de
+ * probe}, como las de multi_zip_iterators; la tupla es del iterador y solo es
+ * válida hasta la siguiente llamada. Si los dos lados son de acceso aleatorio
+ * y probe es más pequeño y estable, la tabla se construye con probe y se
+ * recorre build, sin cambiar el orden dentro de las tuplas. Con
+ * JOIN_LEFT_SEMI y JOIN_ANTI se entregan directamente elementos de probe.
+ *
+ * Los elementos del lado de la tabla deben seguir siendo válidos después de
+ * leerlos (iterator_stable_elements); probe puede ser cualquier iterador.
+ */
+Iterator hash_join_iterator_mode(Iterator build, Iterator probe, JoinMode mode, JoinKeyFunc key_fn,
+                                 JoinHashFunc hash_fn, JoinEqualFunc eq_fn)
+{
+    if (!hash_fn || !eq_fn || !iterator_stable_elements(&build))
+        return (Iterator){0};
+
+    HashJoinIterator *impl = malloc(sizeof(HashJoinIterator));
+    if (!impl)
+        return (Iterator){0};
+
+    *impl = (HashJoinIterator){
+        .build = build,
+        .probe = probe,
+        .mode = mode,
+        .key_fn = key_fn,
+        .hash_fn = hash_fn,
+        .eq_fn = eq_fn,
+        .swapped = mode == JOIN_INNER && iterator_stable_elements(&probe) && iterator_is_random_access(&build) &&
+                   iterator_is_random_access(&probe) && iterator_size(&probe) < iterator_size(&build)
+    };
+
+    if (!join_build(impl))
+    {
+        free(impl);
+        return (Iterator){0};
+    }
+
+    return (Iterator){
+        .ops = &hash_join_iterator_ops,
+        .category = INPUT_ITERATOR,
+        .impl = impl,
+        .current = NULL
+    };
+}
+
+/**
+ * @brief Crea un inner hash join entre build y probe (ver hash_join_iterator_mode)
+ */
+Iterator hash_join_iterator(Iterator build, Iterator probe, JoinKeyFunc key_fn,
+                            JoinHashFunc hash_fn, JoinEqualFunc eq_fn)
+{
+    return hash_join_iterator_mode(build, probe, JOIN_INNER, key_fn, hash_fn, eq_fn);
+}
+
+#endif // CJOIN_C
@@ -0,0 +1,843 @@
+/**
+ * @file CSearch.c
+ * @brief Implementación de lower_bound, upper_bound, equal_range y binary_search
+ *
+ * La búsqueda no tiene saltos dependientes de la comparación: en cada paso el
+ * rango se reduce a la mitad y el inicio se actualiza con una selección
+ * (cmov), de modo que el coste es siempre ceil(log2(n)) comparaciones sin
+ * fallos de predicción. Para vistas grandes se precargan los dos candidatos
+ * del paso siguiente mientras se resuelve la comparación actual.
+ *
+ * SearchIndex cambia la disposición de los datos en lugar del algoritmo: orden
+ * de Eytzinger para comparadores arbitrarios y B-tree estático con nodos de
+ * una línea de caché, comparados con AVX2, para claves enteras.
+ *
+ * Los iteradores de operaciones de conjuntos saltan con galope los tramos que
+ * no aportan nada: intersecar m elementos con n cuesta O(m log(n / m)).
+ */
+
+#ifndef CSEARCH_C
+#define CSEARCH_C
+
+#include "CSearch.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define search_prefetch(p) __builtin_prefetch((p))
+#else
+#define search_prefetch(p) ((void)(p))
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEARCH_SIMD_AVAILABLE 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Devuelve la implementación si el iterador es un GenericArrayIterator, NULL si no.
+ */
+static const GenericArrayIterator *search_array(const Iterator *it)
+{
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops)
+        return NULL;
+    return (const GenericArrayIterator *)it->impl;
+}
+
+/**
+ * @brief Precarga el elemento i: la entrada de la tabla si existe (el elemento
+ *        depende de ella) o el propio elemento.
+ */
+static inline void search_prefetch_at(const GenericArrayIterator *iter, size_t i)
+{
+    if (iter->elements)
+        search_prefetch(&iter->elements[i]);
+    else
+        search_prefetch(iter->base + i * iter->stride);
+}
+
+/**
+ * @brief Primera posición de [first, first + len) cuyo elemento no va antes de value
+ *        (con `upper`, la primera cuyo elemento va después).
+ */
+static size_t search_bound(const GenericArrayIterator *iter, size_t first, size_t len,
+                           const void *value, CompareFunc compare, bool upper)
+{
+    if (len == 0)
+        return first;
+
+    size_t base = first;
+    while (len > 1)
+    {
+        size_t half = len / 2;
+        if (len >= SEARCH_PREFETCH_MIN)
+        {
+            search_prefetch_at(iter, base + half / 2);
+            search_prefetch_at(iter, base + half + half / 2);
+        }
+        int c = compare(generic_array_get(iter, base + half), value);
+        base = (upper ? c <= 0 : c < 0) ? base + half : base;
+        len -= half;
+    }
+
+    int c = compare(generic_array_get(iter, base), value);
+    return base + (upper ? c <= 0 : c < 0);
+}
+
+/**
+ * @brief Primera posición a partir de first cuyo elemento no es menor que value,
+ *        con búsqueda exponencial (galope).
+ *
+ * Compara en first, first + 1, first + 3, first + 7, ... hasta pasarse de
+ * value y termina con search_bound en el último tramo, así que cuesta
+ * O(log d) comparaciones, siendo d la distancia hasta el resultado.
+ */
+static size_t search_gallop(const GenericArrayIterator *iter, size_t first, const void *value,
+                            CompareFunc compare)
+{
+    size_t lo = first, hi = first, step = 1;
+    while (hi < iter->size && compare(generic_array_get(iter, hi), value) < 0)
+    {
+        lo = hi + 1;
+        hi = lo + step;
+        step *= 2;
+    }
+    if (hi > iter->size)
+        hi = iter->size;
+    return search_bound(iter, lo, hi - lo, value, compare, false);
+}
+
+/**
+ * @brief Primera posición cuyo elemento no es menor que value
+ * @param it GenericArrayIterator con la vista ordenada
+ * @param value Valor buscado, se pasa como segundo argumento a compare
+ * @param compare Función de comparación con la que se ordenó la vista
+ * @return Posición en [0, size]; size si todos los elementos son menores
+ *         (o 0 si el iterador no es un GenericArrayIterator)
+ */
+size_t generic_lower_bound(const Iterator *it, const void *value, CompareFunc compare)
+{
+    const GenericArrayIterator *iter = search_array(it);
+    return iter ? search_bound(iter, 0, iter->size, value, compare, false) : 0;
+}
+
+/**
+ * @brief Primera posición cuyo elemento es mayor que value
+ * @param it GenericArrayIterator con la vista ordenada
+ * @param value Valor buscado, se pasa como segundo argumento a compare
+ * @param compare Función de comparación con la que se ordenó la vista
+ * @return Posición en [0, size]; size si ningún elemento es mayor
+ *         (o 0 si el iterador no es un GenericArrayIterator)
+ */
+size_t generic_upper_bound(const Iterator *it, const void *value, CompareFunc compare)
+{
+    const GenericArrayIterator *iter = search_array(it);
+    return iter ? search_bound(iter, 0, iter->size, value, compare, true) : 0;
+}
+
+/**
+ * @brief Rango de posiciones [first, last) cuyos elementos son iguales a value
+ * @param it GenericArrayIterator con la vista ordenada
+ * @param value Valor buscado, se pasa como segundo argumento a compare
+ * @param compare Función de comparación con la que se ordenó la vista
+ * @param first Recibe lower_bound(value)
+ * @param last Recibe upper_bound(value)
+ * @return true si hay al menos un elemento igual a value
+ */
+bool generic_equal_range(const Iterator *it, const void *value, CompareFunc compare,
+                         size_t *first, size_t *last)
+{
+    const GenericArrayIterator *iter = search_array(it);
+    size_t lo = 0, hi = 0;
+
+    if (iter)
+    {
+        lo = search_bound(iter, 0, iter->size, value, compare, false);
+        // upper_bound no puede estar antes de lower_bound
+        hi = search_bound(iter, lo, iter->size - lo, value, compare, true);
+    }
+    if (first)
+        *first = lo;
+    if (last)
+        *last = hi;
+    return hi > lo;
+}
+
+/**
+ * @brief Busca un elemento igual a value en O(log n)
+ * @param it GenericArrayIterator con la vista ordenada
+ * @param value Valor buscado, se pasa como segundo argumento a compare
+ * @param compare Función de comparación con la que se ordenó la vista
+ * @return Puntero al primer elemento igual a value, o NULL si no hay ninguno
+ *
+ * Equivale a iterator_find sobre una vista ordenada, sin mover el iterador.
+ */
+void *generic_binary_search(const Iterator *it, const void *value, CompareFunc compare)
+{
+    const GenericArrayIterator *iter = search_array(it);
+    if (!iter)
+        return NULL;
+
+    size_t pos = search_bound(iter, 0, iter->size, value, compare, false);
+    if (pos == iter->size)
+        return NULL;
+
+    void *element = generic_array_get(iter, pos);
+    return compare(element, value) == 0 ? element : NULL;
+}
+
+/*
+ * SearchIndex
+ */
+
+#define SEARCH_INDEX_PREFETCH 16 /**< Eytzinger: los descendientes de k cuatro niveles más abajo empiezan en 16k. */
+#define SEARCH_INDEX_ALIGN 64    /**< Alineación de los nodos del B-tree (una línea de caché). */
+#define SEARCH_INDEX_SIGN ((uint64_t)1 << 63)
+
+/**
+ * @struct SearchSource
+ * @brief Elementos ordenados de los que se construye un índice: un
+ *        GenericArrayIterator o un array de registros.
+ */
+typedef struct SearchSource {
+    const GenericArrayIterator *iter; /**< Vista del iterador, o NULL para registros. */
+    const char *base;                 /**< Primer registro si iter es NULL. */
+    size_t element_size;              /**< Tamaño de cada elemento. */
+    size_t count;                     /**< Número de elementos. */
+} SearchSource;
+
+static inline void *search_source_get(const SearchSource *src, size_t i)
+{
+    return src->iter ? generic_array_get(src->iter, i) : (void *)(src->base + i * src->element_size);
+}
+
+static bool search_source_iterator(SearchSource *src, const Iterator *it)
+{
+    const GenericArrayIterator *iter = search_array(it);
+    if (!iter)
+        return false;
+    *src = (SearchSource){ .iter = iter, .element_size = iter->element_size, .count = iter->size };
+    return true;
+}
+
+static bool search_source_records(SearchSource *src, const void *base, size_t count, size_t element_size)
+{
+    if ((!base && count > 0) || element_size == 0)
+        return false;
+    *src = (SearchSource){ .base = base, .element_size = element_size, .count = count };
+    return true;
+}
+
+/**
+ * @brief Recorre en orden el subárbol de Eytzinger de la posición k copiando
+ *        en él los elementos siguientes de la fuente.
+ */
+static void eytzinger_fill(SearchIndex *index, const SearchSource *src, size_t *next, size_t k)
+{
+    if (k > index->size)
+        return;
+
+    eytzinger_fill(index, src, next, 2 * k);
+    void *element = search_source_get(src, (*next)++);
+    memcpy(index->records + k * index->element_size, element, index->element_size);
+    index->origin[k] = element;
+    eytzinger_fill(index, src, next, 2 * k + 1);
+}
+
+static SearchIndex eytzinger_build(const SearchSource *src, CompareFunc compare)
+{
+    SearchIndex index = { .size = src->count, .element_size = src->element_size, .compare = compare };
+    if (!compare)
+        return (SearchIndex){0};
+
+    index.records = malloc((src->count + 1) * src->element_size);
+    index.origin = malloc((src->count + 1) * sizeof(void *));
+    if (!index.records || !index.origin)
+    {
+        free(index.records);
+        free(index.origin);
+        return (SearchIndex){0};
+    }
+
+    size_t next = 0;
+    index.origin[0] = NULL;
+    eytzinger_fill(&index, src, &next, 1);
+    return index;
+}
+
+/**
+ * @brief Posición de Eytzinger del primer elemento no menor que value, 0 si no hay.
+ *
+ * El descenso va a 2k si el nodo no es menor que value y a 2k + 1 si lo es.
+ * Al salir del árbol, los bits bajos de k a 1 son los giros a la derecha del
+ * final del camino: quitándolos junto con el último giro a la izquierda queda
+ * el último nodo que no era menor, que es la respuesta.
+ */
+static size_t eytzinger_lower_bound(const SearchIndex *index, const void *value)
+{
+    const size_t n = index->size, esize = index->element_size;
+    size_t k = 1;
+
+    while (k <= n)
+    {
+        if (k * SEARCH_INDEX_PREFETCH <= n)
+            search_prefetch(index->records + k * SEARCH_INDEX_PREFETCH * esize);
+        k = 2 * k + (index->compare(index->records + k * esize, value) < 0);
+    }
+
+    while (k & 1)
+        k >>= 1;
+    return k >> 1;
+}
+
+/**
+ * @brief Hijo i (0..SEARCH_INDEX_NODE_KEYS) del nodo k del B-tree.
+ */
+static inline size_t btree_child(size_t k, size_t i)
+{
+    return k * (SEARCH_INDEX_NODE_KEYS + 1) + i + 1;
+}
+
+/**
+ * @brief Clave normalizada con el bit de signo invertido, para que la
+ *        comparación con signo de AVX2 respete el orden sin signo.
+ */
+static inline int64_t btree_flip(uint64_t normalized)
+{
+    return (int64_t)(normalized ^ SEARCH_INDEX_SIGN);
+}
+
+/**
+ * @brief Recorre en orden el subárbol del nodo k rellenando sus claves con
+ *        los elementos siguientes de la fuente. Las posiciones que sobran al
+ *        final llevan la clave máxima y ningún elemento.
+ */
+static void btree_fill(SearchIndex *index, const SearchSource *src, size_t *next, size_t k)
+{
+    if (k >= index->nodes)
+        return;
+
+    for (size_t i = 0; i < SEARCH_INDEX_NODE_KEYS; i++)
+    {
+        btree_fill(index, src, next, btree_child(k, i));
+
+        size_t slot = k * SEARCH_INDEX_NODE_KEYS + i;
+        if (*next < src->count)
+        {
+            void *element = search_source_get(src, (*next)++);
+            index->keys[slot] = btree_flip(radix_key_value(element, &index->key));
+            index->origin[slot] = element;
+        }
+        else
+        {
+            index->keys[slot] = INT64_MAX;
+            index->origin[slot] = NULL;
+        }
+    }
+    btree_fill(index, src, next, btree_child(k, SEARCH_INDEX_NODE_KEYS));
+}
+
+static SearchIndex btree_build(const SearchSource *src, const RadixKey *key)
+{
+    if (!radix_key_valid(key))
+        return (SearchIndex){0};
+
+    SearchIndex index = { .size = src->count, .element_size = src->element_size, .key = *key };
+    index.nodes = (src->count + SEARCH_INDEX_NODE_KEYS - 1) / SEARCH_INDEX_NODE_KEYS;
+
+    // Al menos un nodo en las reservas para que un índice vacío también sea válido
+    size_t slots = (index.nodes ? index.nodes : 1) * SEARCH_INDEX_NODE_KEYS;
+    index.allocation = malloc(slots * sizeof(int64_t) + SEARCH_INDEX_ALIGN);
+    index.origin = malloc(slots * sizeof(void *));
+    if (!index.allocation || !index.origin)
+    {
+        free(index.allocation);
+        free(index.origin);
+        return (SearchIndex){0};
+    }
+    uintptr_t aligned = ((uintptr_t)index.allocation + SEARCH_INDEX_ALIGN - 1) & ~(uintptr_t)(SEARCH_INDEX_ALIGN - 1);
+    index.keys = (int64_t *)aligned;
+
+    size_t next = 0;
+    btree_fill(&index, src, &next, 0);
+    return index;
+}
+
+/**
+ * @brief Número de claves del nodo menores que x.
+ */
+static inline unsigned btree_rank(const int64_t *node, int64_t x)
+{
+    unsigned rank = 0;
+    for (size_t i = 0; i < SEARCH_INDEX_NODE_KEYS; i++)
+        rank += node[i] < x;
+    return rank;
+}
+
+#ifdef SEARCH_SIMD_AVAILABLE
+/**
+ * @brief btree_rank con dos comparaciones de 4 claves y un popcount de la máscara.
+ */
+__attribute__((target("avx2,popcnt"))) static inline unsigned btree_rank_avx2(const int64_t *node, int64_t x)
+{
+    __m256i vx = _mm256_set1_epi64x(x);
+    __m256i lo = _mm256_cmpgt_epi64(vx, _mm256_load_si256((const __m256i *)node));
+    __m256i hi = _mm256_cmpgt_epi64(vx, _mm256_load_si256((const __m256i *)node + 1));
+    unsigned mask = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(lo)) |
+                    (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4;
+    return (unsigned)__builtin_popcount(mask);
+}
+
+/**
+ * @brief Descenso completo con AVX2; separado para que todo el bucle se
+ *        compile con el juego de instrucciones y la comparación se integre.
+ */
+__attribute__((target("avx2,popcnt"))) static size_t btree_descend_avx2(const SearchIndex *index, int64_t x)
+{
+    size_t k = 0, slot = SIZE_MAX;
+    while (k < index->nodes)
+    {
+        unsigned i = btree_rank_avx2(index->keys + k * SEARCH_INDEX_NODE_KEYS, x);
+        slot = i < SEARCH_INDEX_NODE_KEYS ? k * SEARCH_INDEX_NODE_KEYS + i : slot;
+        k = btree_child(k, i);
+    }
+    return slot;
+}
+#endif
+
+/**
+ * @brief Posición en el B-tree de la primera clave no menor que la clave
+ *        normalizada dada, SIZE_MAX si no hay ninguna.
+ *
+ * En cada nodo, el número de claves menores es a la vez la posición candidata
+ * dentro del nodo y el hijo por el que seguir bajando.
+ */
+static size_t btree_lower_bound(const SearchIndex *index, uint64_t normalized)
+{
+    int64_t x = btree_flip(normalized);
+
+#ifdef SEARCH_SIMD_AVAILABLE
+    if (__builtin_cpu_supports("avx2"))
+        return btree_descend_avx2(index, x);
+#endif
+
+    size_t k = 0, slot = SIZE_MAX;
+    while (k < index->nodes)
+    {
+        unsigned i = btree_rank(index->keys + k * SEARCH_INDEX_NODE_KEYS, x);
+        slot = i < SEARCH_INDEX_NODE_KEYS ? k * SEARCH_INDEX_NODE_KEYS + i : slot;
+        k = btree_child(k, i);
+    }
+    return slot;
+}
+
+/**
+ * @brief Elemento original del B-tree igual a la clave normalizada, o NULL.
+ */
+static void *btree_find(const SearchIndex *index, uint64_t normalized)
+{
+    size_t slot = btree_lower_bound(index, normalized);
+    if (slot == SIZE_MAX || index->keys[slot] != btree_flip(normalized))
+        return NULL;
+    return index->origin[slot];
+}
+
+/**
+ * @brief Construye un índice de Eytzinger sobre la vista ordenada de un GenericArrayIterator
+ * @param it GenericArrayIterator con la vista ordenada según compare
+ * @param compare Función de comparación con la que se ordenó la vista
+ * @return Índice; si no se pudo construir, su campo origin es NULL
+ *
+ * Copia los elementos (size * element_size bytes) y guarda un puntero al
+ * original por cada uno. El iterador no se modifica.
+ */
+SearchIndex search_index_build(const Iterator *it, CompareFunc compare)
+{
+    SearchSource src;
+    return search_source_iterator(&src, it) ? eytzinger_build(&src, compare) : (SearchIndex){0};
+}
+
+/**
+ * @brief Construye un índice de Eytzinger sobre un array de registros ordenado
+ * @param base Primer registro
+ * @param count Número de registros
+ * @param element_size Tamaño de cada registro en bytes
+ * @param compare Función de comparación con la que se ordenó el array
+ * @return Índice; si no se pudo construir, su campo origin es NULL
+ */
+SearchIndex search_index_build_records(const void *base, size_t count, size_t element_size,
+                                       CompareFunc compare)
+{
+    SearchSource src;
+    return search_source_records(&src, base, count, element_size) ? eytzinger_build(&src, compare)
+                                                                   : (SearchIndex){0};
+}
+
+/**
+ * @brief Construye un B-tree estático de claves enteras sobre la vista ordenada de un GenericArrayIterator
+ * @param it GenericArrayIterator con la vista ordenada por la clave
+ * @param key Descripción de la clave, como en generic_radix_sort
+ * @return Índice; si no se pudo construir, su campo origin es NULL
+ *
+ * Ocupa 16 bytes por elemento (clave y puntero) sea cual sea su tamaño.
+ */
+SearchIndex search_index_build_keyed(const Iterator *it, const RadixKey *key)
+{
+    SearchSource src;
+    return search_source_iterator(&src, it) ? btree_build(&src, key) : (SearchIndex){0};
+}
+
+/**
+ * @brief Construye un B-tree estático de claves enteras sobre un array de registros ordenado
+ * @param base Primer registro
+ * @param count Número de registros
+ * @param element_size Tamaño de cada registro en bytes
+ * @param key Descripción de la clave, como en generic_radix_sort_records
+ * @return Índice; si no se pudo construir, su campo origin es NULL
+ */
+SearchIndex search_index_build_keyed_records(const void *base, size_t count, size_t element_size,
+                                             const RadixKey *key)
+{
+    SearchSource src;
+    return search_source_records(&src, base, count, element_size) ? btree_build(&src, key)
+                                                                   : (SearchIndex){0};
+}
+
+/**
+ * @brief Primer elemento que no es menor que value
+ * @param index Índice construido con search_index_build*
+ * @param value Valor buscado: segundo argumento de compare, o un elemento del
+ *        que se lee la clave en los índices por clave
+ * @return Puntero al elemento original, o NULL si todos son menores
+ */
+void *search_index_lower_bound(const SearchIndex *index, const void *value)
+{
+    if (!index || !index->origin)
+        return NULL;
+
+    if (index->compare)
+        return index->origin[eytzinger_lower_bound(index, value)];
+
+    size_t slot = btree_lower_bound(index, radix_key_value(value, &index->key));
+    return slot == SIZE_MAX ? NULL : index->origin[slot];
+}
+
+/**
+ * @brief Busca un elemento igual a value
+ * @param index Índice construido con search_index_build*
+ * @param value Valor buscado: segundo argumento de compare, o un elemento del
+ *        que se lee la clave en los índices por clave
+ * @return Puntero al primer elemento original igual a value, o NULL si no hay ninguno
+ */
+void *search_index_find(const SearchIndex *index, const void *value)
+{
+    if (!index || !index->origin)
+        return NULL;
+
+    if (!index->compare)
+        return btree_find(index, radix_key_value(value, &index->key));
+
+    size_t k = eytzinger_lower_bound(index, value);
+    if (k == 0 || index->compare(index->records + k * index->element_size, value) != 0)
+        return NULL;
+    return index->origin[k];
+}
+
+/**
+ * @brief Busca por el valor de la clave en un índice por clave entera
+ * @param index Índice construido con search_index_build_keyed*
+ * @param key Bits de la clave, como los devolvería RadixKey::key_fn (por
+ *        ejemplo (uint64_t)(int64_t)x para claves con signo)
+ * @return Puntero al primer elemento original con esa clave, o NULL si no hay
+ *         ninguno o el índice no es por clave
+ */
+void *search_index_find_key(const SearchIndex *index, uint64_t key)
+{
+    if (!index || !index->origin || index->compare)
+        return NULL;
+    return btree_find(index, radix_key_normalize(key, &index->key));
+}
+
+/**
+ * @brief Libera la memoria de un índice y lo deja vacío
+ * @param index Índice a liberar
+ */
+void search_index_destroy(SearchIndex *index)
+{
+    if (!index)
+        return;
+    free(index->records);
+    free(index->origin);
+    free(index->allocation);
+    *index = (SearchIndex){0};
+}
+
+/*
+ * Operaciones de conjuntos sobre dos iteradores ordenados
+ */
+
+/**
+ * @brief Prepara una entrada: acceso directo a la vista si es un
+ *        GenericArrayIterator, lectura por lotes si no.
+ */
+static void set_side_init(SetSide *side, Iterator src)
+{
+    *side = (SetSide){ .source = src, .array = search_array(&src) };
+    if (side->array)
+    {
+        // Se continúa donde lo dejaría next(): index es (size_t)-1 antes de empezar
+        side->position = side->array->index + 1;
+        side->length = side->array->size;
+    }
+}
+
+static inline bool set_side_needs_fill(const SetSide *side)
+{
+    return !side->array && !side->exhausted && side->position >= side->length;
+}
+
+/**
+ * @brief Lee el siguiente lote de una entrada leída por lotes, si ya agotó el actual.
+ */
+static void set_side_fill(SetSide *side)
+{
+    if (!set_side_needs_fill(side))
+        return;
+    side->position = 0;
+    side->length = iterator_next_batch(&side->source, side->buffer, ITERATOR_BATCH_SIZE);
+    side->exhausted = side->length == 0;
+}
+
+/**
+ * @brief Siguiente elemento de una entrada, NULL si se agotó.
+ */
+static inline void *set_side_head(const SetSide *side)
+{
+    if (side->position >= side->length)
+        return NULL;
+    return side->array ? generic_array_get(side->array, side->position) : side->buffer[side->position];
+}
+
+/**
+ * @brief Entrega hasta `max` elementos de la entrada menores que bound (todos si es NULL).
+ *
+ * El primero ya se sabe menor que bound. En una vista, el final del tramo se
+ * busca con galope y se copia entero.
+ */
+static size_t set_side_emit(SetSide *side, const void *bound, CompareFunc compare, void **out, size_t max)
+{
+    size_t n = 0;
+
+    if (side->array)
+    {
+        size_t end = bound ? search_gallop(side->array, side->position + 1, bound, compare) : side->length;
+        if (end - side->position < max)
+            max = end - side->position;
+        for (; n < max; n++)
+            out[n] = generic_array_get(side->array, side->position + n);
+        side->position += n;
+        return n;
+    }
+
+    do
+        out[n++] = side->buffer[side->position++];
+    while (n < max && side->position < side->length &&
+           (!bound || compare(side->buffer[side->position], bound) < 0));
+    return n;
+}
+
+/**
+ * @brief Descarta los elementos de la entrada menores que bound (el primero ya se sabe menor).
+ */
+static void set_side_skip(SetSide *side, const void *bound, CompareFunc compare)
+{
+    if (side->array)
+    {
+        side->position = search_gallop(side->array, side->position + 1, bound, compare);
+        return;
+    }
+
+    do
+        side->position++;
+    while (side->position < side->length && compare(side->buffer[side->position], bound) < 0);
+}
+
+/**
+ * @brief Calcula hasta `max` elementos más de la operación.
+ *
+ * El lote se corta antes de rellenar una entrada (ver IteratorOps).
+ */
+static size_t set_fill(SetOperationIterator *iter, void **out, size_t max)
+{
+    bool emit_a = iter->op != SET_INTERSECTION;
+    bool emit_b = iter->op == SET_UNION || iter->op == SET_SYMMETRIC_DIFFERENCE;
+    bool emit_equal = iter->op == SET_UNION || iter->op == SET_INTERSECTION;
+    size_t n = 0;
+
+    while (n < max && !iter->done)
+    {
+        if (set_side_needs_fill(&iter->a) || set_side_needs_fill(&iter->b))
+        {
+            if (n > 0)
+                break;
+            set_side_fill(&iter->a);
+            set_side_fill(&iter->b);
+        }
+
+        void *x = set_side_head(&iter->a);
+        void *y = set_side_head(&iter->b);
+        if ((!x && !y) || (!x && !emit_b) || (!y && !emit_a))
+        {
+            iter->done = true;
+            break;
+        }
+
+        int c = !x ? 1 : !y ? -1 : iter->compare(x, y);
+        if (c < 0)
+        {
+            if (emit_a)
+                n += set_side_emit(&iter->a, y, iter->compare, out + n, max - n);
+            else
+                set_side_skip(&iter->a, y, iter->compare);
+        }
+        else if (c > 0)
+        {
+            if (emit_b)
+                n += set_side_emit(&iter->b, x, iter->compare, out + n, max - n);
+            else
+                set_side_skip(&iter->b, x, iter->compare);
+        }
+        else
+        {
+            if (emit_equal)
+                out[n++] = x;
+            iter->a.position++;
+            iter->b.position++;
+        }
+    }
+    return n;
+}
+
+static void *set_next(Iterator *it)
+{
+    void *element;
+
+    if (!set_fill((SetOperationIterator *)it->impl, &element, 1))
+    {
+        it->current = NULL;
+        return NULL;
+    }
+
+    it->current = element;
+    return it;
+}
+
+static size_t set_next_batch(Iterator *it, void **out, size_t max)
+{
+    size_t n = set_fill((SetOperationIterator *)it->impl, out, max);
+    it->current = n ? out[n - 1] : NULL;
+    return n;
+}
+
+static bool set_equal(const Iterator *a, const Iterator *b)
+{
+    return a->impl == b->impl && a->current == b->current;
+}
+
+static void *set_deref(const Iterator *it)
+{
+    return it->current;
+}
+
+static bool set_stable_elements(const Iterator *it)
+{
+    const SetOperationIterator *iter = (const SetOperationIterator *)it->impl;
+    return iterator_stable_elements(&iter->a.source) && iterator_stable_elements(&iter->b.source);
+}
+
+static void set_destroy(Iterator *it)
+{
+    SetOperationIterator *iter = (SetOperationIterator *)it->impl;
+    iterator_destroy(&iter->a.source);
+    iterator_destroy(&iter->b.source);
+    free(iter);
+    it->impl = NULL;
+}
+
+/** Tabla de operaciones compartida por todos los SetOperationIterator. */
+static const IteratorOps set_operation_iterator_ops = {
+    .next = set_next,
+    .equal = set_equal,
+    .deref = set_deref,
+    .destroy = set_destroy,
+    .next_batch = set_next_batch,
+    .stable_elements = set_stable_elements
+};
+
+/**
+ * @brief Crea un iterador que calcula bajo demanda una operación de conjuntos
+ * @param a Primera entrada, ordenada según compare; pasa a ser propiedad del nuevo iterador
+ * @param b Segunda entrada, ordenada según compare; pasa a ser propiedad del nuevo iterador
+ * @param op Operación a calcular (ver SetOperation)
+ * @param compare Función de comparación con la que están ordenadas las entradas
+ * @return Iterador de una sola pasada, o un iterador nulo si no hay memoria
+ *         (en ese caso las entradas siguen siendo del llamador)
+ *
+ * Los elementos salen en orden; a igualdad se entrega el de `a`. Las
+ * entradas que son GenericArrayIterator se leen directamente de su vista
+ * (desde donde lo haría next()) y los tramos que se descartan o se entregan
+ * enteros se localizan con galope, así que intersecar una lista de m
+ * elementos con una vista de n cuesta O(m log(n / m)) comparaciones. El resto
+ * de iteradores se leen por lotes y se comparan elemento a elemento.
+ */
+Iterator set_operation_iterator(Iterator a, Iterator b, SetOperation op, CompareFunc compare)
+{
+    SetOperationIterator *impl = malloc(sizeof(SetOperationIterator));
+    if (!impl)
+        return (Iterator){0};
+
+    set_side_init(&impl->a, a);
+    set_side_init(&impl->b, b);
+    impl->op = op;
+    impl->compare = compare;
+    impl->done = false;
+
+    return (Iterator){
+        .ops = &set_operation_iterator_ops,
+        .category = INPUT_ITERATOR,
+        .impl = impl,
+        .current = NULL
+    };
+}
+
+/**
+ * @brief Unión ordenada de a y b (ver set_operation_iterator)
+ */
+Iterator set_union(Iterator a, Iterator b, CompareFunc compare)
+{
+    return set_operation_iterator(a, b, SET_UNION, compare);
+}
+
+/**
+ * @brief Intersección ordenada de a y b (ver set_operation_iterator)
+ */
+Iterator set_intersection(Iterator a, Iterator b, CompareFunc compare)
+{
+    return set_operation_iterator(a, b, SET_INTERSECTION, compare);
+}
+
+/**
+ * @brief Elementos de a que no están en b, en orden (ver set_operation_iterator)
+ */
+Iterator set_difference(Iterator a, Iterator b, CompareFunc compare)
+{
+    return set_operation_iterator(a, b, SET_DIFFERENCE, compare);
+}
+
+/**
+ * @brief Elementos que están solo en a o solo en b, en orden (ver set_operation_iterator)
+ */
+Iterator set_symmetric_difference(Iterator a, Iterator b, CompareFunc compare)
+{
+    return set_operation_iterator(a, b, SET_SYMMETRIC_DIFFERENCE, compare);
+}
+
+#endif // CSEARCH_C
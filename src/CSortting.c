@@ -1,10 +1,11 @@
 /**
  * @file CSorting.c
- * @brief Implementación del algoritmo Introsort usando iteradores genéricos
+ * @brief Implementación de pattern-defeating quicksort usando iteradores genéricos
  *
  * Este archivo contiene la implementación de un algoritmo de ordenación híbrido
- * (Introsort) que combina QuickSort, HeapSort e Insertion Sort, diseñado para
- * trabajar con la estructura de iteradores genéricos definida en CIterators.h
+ * (pdqsort, derivado de Introsort) que combina QuickSort, HeapSort e Insertion
+ * Sort, diseñado para trabajar con la estructura de iteradores genéricos
+ * definida en CIterators.h. El motor está en CSorttingTemplate.h.
  */
 
 #ifndef CSORTING_C
@@ -12,220 +13,2985 @@
 
 #include "CSortting.h"
 
+#include <stddef.h> // para size_t
+#include <stdint.h>
+#include <pthread.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static inline int log2_int(size_t n) {
+    if (n == 0) return -1; // indefinido para log2(0)
+
+#if defined(__GNUC__) || defined(__clang__)
+#if SIZE_MAX == UINT64_MAX
+    return 63 - __builtin_clzll(n);
+#else
+    return 31 - __builtin_clz((unsigned int)n);
+#endif
+
+#elif defined(_MSC_VER)
+#include <intrin.h>
+    unsigned long index;
+#if defined(_M_X64) || defined(_M_ARM64)
+    _BitScanReverse64(&index, n);
+#else
+    _BitScanReverse(&index, (unsigned long)n);
+#endif
+    return (int)index;
+
+#else
+    // Fallback portable version
+    int res = 0;
+    while (n >>= 1) res++;
+    return res;
+#endif
+}
+
+/**
+ * @brief Prepara un GenericArrayIterator para ordenar su vista (tabla de punteros).
+ * @param it Iterador a ordenar.
+ * @return La tabla de punteros a ordenar, o NULL si no hay nada que ordenar
+ *         (iterador inválido, de otro tipo, con menos de dos elementos o sin memoria).
+ */
+static void **sort_prepare_table(Iterator *it)
+{
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops)
+        return NULL;
+
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    if (iter->size <= 1)
+        return NULL;
+
+    // Se ordena la vista (tabla de punteros), no el buffer original
+    return generic_array_table(iter);
+}
+
+/**
+ * @brief Deja el iterador sobre el primer elemento tras ordenarlo.
+ * @param it Iterador ya ordenado.
+ */
+static void sort_finish(Iterator *it)
+{
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+
+    // Resetear el índice después de ordenar
+    iter->index = 0;
+    it->current = iter->size ? generic_array_get(iter, 0) : NULL;
+}
+
+/**
+ * @struct PointerSortContext
+ * @brief Contexto del motor de ordenación sobre la tabla de punteros de un GenericArrayIterator.
+ */
+typedef struct PointerSortContext {
+    void **elements;     /**< Tabla de punteros a ordenar. */
+    CompareFunc compare; /**< Función de comparación sobre los elementos apuntados. */
+} PointerSortContext;
+
+/**
+ * @struct TypedSortContext
+ * @brief Contexto de las ordenaciones por tipo primitivo (ver CSorttingTyped.h).
+ */
+typedef struct TypedSortContext {
+    void *data; /**< Array del tipo o tabla de punteros, según la variante. */
+} TypedSortContext;
+
+#define SORT_NAME(name) pointer_##name
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX PointerSortContext
+#define SORT_LESS(ctx, i, j) ((ctx)->compare((ctx)->elements[i], (ctx)->elements[j]) < 0)
+#define SORT_SWAP(ctx, i, j)                      \
+    do {                                          \
+        void *tmp_ = (ctx)->elements[i];          \
+        (ctx)->elements[i] = (ctx)->elements[j];  \
+        (ctx)->elements[j] = tmp_;                \
+    } while (0)
+#define SORT_VALUE_T void *
+#define SORT_GET(ctx, i) ((ctx)->elements[i])
+#define SORT_SET(ctx, i, v) ((ctx)->elements[i] = (v))
+#define SORT_VALUE_LESS(ctx, v, i) ((ctx)->compare((v), (ctx)->elements[i]) < 0)
+#include "CSorttingTemplate.h"
+
+/**
+ * @struct ArgsortEntry
+ * @brief Elemento de argsort: puntero a los datos a comparar y su posición original.
+ *
+ * El puntero va primero para que una SortLayout indirecta compare lo apuntado
+ * igual que con la tabla de punteros de un GenericArrayIterator.
+ */
+typedef struct ArgsortEntry {
+    void *element; /**< Elemento que se compara. */
+    size_t index;  /**< Posición del elemento en la vista original. */
+} ArgsortEntry;
+
+/**
+ * @struct ArgsortContext
+ * @brief Contexto del motor de ordenación sobre las entradas de argsort.
+ */
+typedef struct ArgsortContext {
+    ArgsortEntry *entries; /**< Entradas a ordenar. */
+    CompareFunc compare;   /**< Función de comparación sobre los elementos apuntados. */
+} ArgsortContext;
+
+#define SORT_NAME(name) argsort_##name
+#define SORT_CTX ArgsortContext
+#define SORT_LESS(ctx, i, j) ((ctx)->compare((ctx)->entries[i].element, (ctx)->entries[j].element) < 0)
+#define SORT_SWAP(ctx, i, j)                    \
+    do {                                        \
+        ArgsortEntry tmp_ = (ctx)->entries[i];  \
+        (ctx)->entries[i] = (ctx)->entries[j];  \
+        (ctx)->entries[j] = tmp_;               \
+    } while (0)
+#define SORT_VALUE_T ArgsortEntry
+#define SORT_GET(ctx, i) ((ctx)->entries[i])
+#define SORT_SET(ctx, i, v) ((ctx)->entries[i] = (v))
+#define SORT_VALUE_LESS(ctx, v, i) ((ctx)->compare((v).element, (ctx)->entries[i].element) < 0)
+#include "CSorttingTemplate.h"
+
+/**
+ * @struct RecordSortContext
+ * @brief Contexto del motor de ordenación sobre los registros originales de un array.
+ */
+typedef struct RecordSortContext {
+    char *base;          /**< Dirección del primer registro. */
+    size_t stride;       /**< Distancia en bytes entre registros consecutivos. */
+    size_t element_size; /**< Tamaño en bytes de cada registro. */
+    CompareFunc compare; /**< Función de comparación sobre los registros. */
+} RecordSortContext;
+
+#define RECORD_AT(ctx, i) ((ctx)->base + (i) * (ctx)->stride)
+
+/**
+ * @brief Intercambia dos registros de `size` bytes usando un buffer intermedio por bloques.
+ */
+static inline void swap_record_bytes(char *a, char *b, size_t size)
+{
+    unsigned char tmp[64];
+    while (size > 0)
+    {
+        size_t chunk = size < sizeof(tmp) ? size : sizeof(tmp);
+        memcpy(tmp, a, chunk);
+        memcpy(a, b, chunk);
+        memcpy(b, tmp, chunk);
+        a += chunk;
+        b += chunk;
+        size -= chunk;
+    }
+}
+
+/*
+ * Registros de tamaño fijo: memcpy con tamaño constante se traduce en
+ * movimientos de registro, sin bucles ni llamadas. Cada tamaño define un tipo
+ * valor para que la ordenación por inserción pueda desplazar en vez de intercambiar.
+ */
+#define DEFINE_FIXED_RECORD(bytes)                                          \
+    typedef struct Record##bytes { unsigned char b[bytes]; } Record##bytes; \
+                                                                            \
+    static inline Record##bytes record##bytes##_get(const char *p)          \
+    {                                                                       \
+        Record##bytes r;                                                    \
+        memcpy(&r, p, bytes);                                               \
+        return r;                                                           \
+    }                                                                       \
+                                                                            \
+    static inline void record##bytes##_set(char *p, Record##bytes r)        \
+    {                                                                       \
+        memcpy(p, &r, bytes);                                               \
+    }                                                                       \
+                                                                            \
+    static inline void swap_record_##bytes(char *a, char *b)                \
+    {                                                                       \
+        Record##bytes tmp = record##bytes##_get(a);                         \
+        memcpy(a, b, bytes);                                                \
+        record##bytes##_set(b, tmp);                                        \
+    }
+
+DEFINE_FIXED_RECORD(4)
+DEFINE_FIXED_RECORD(8)
+DEFINE_FIXED_RECORD(16)
+DEFINE_FIXED_RECORD(32)
+
+#undef DEFINE_FIXED_RECORD
+
+#define RECORD_LESS(ctx, i, j) ((ctx)->compare(RECORD_AT(ctx, i), RECORD_AT(ctx, j)) < 0)
+#define RECORD_VALUE_LESS(ctx, v, i) ((ctx)->compare(&(v), RECORD_AT(ctx, i)) < 0)
+
+#define SORT_NAME(name) record4_##name
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX RecordSortContext
+#define SORT_LESS RECORD_LESS
+#define SORT_SWAP(ctx, i, j) swap_record_4(RECORD_AT(ctx, i), RECORD_AT(ctx, j))
+#define SORT_VALUE_T Record4
+#define SORT_GET(ctx, i) record4_get(RECORD_AT(ctx, i))
+#define SORT_SET(ctx, i, v) record4_set(RECORD_AT(ctx, i), (v))
+#define SORT_VALUE_LESS RECORD_VALUE_LESS
+#include "CSorttingTemplate.h"
+
+#define SORT_NAME(name) record8_##name
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX RecordSortContext
+#define SORT_LESS RECORD_LESS
+#define SORT_SWAP(ctx, i, j) swap_record_8(RECORD_AT(ctx, i), RECORD_AT(ctx, j))
+#define SORT_VALUE_T Record8
+#define SORT_GET(ctx, i) record8_get(RECORD_AT(ctx, i))
+#define SORT_SET(ctx, i, v) record8_set(RECORD_AT(ctx, i), (v))
+#define SORT_VALUE_LESS RECORD_VALUE_LESS
+#include "CSorttingTemplate.h"
+
+#define SORT_NAME(name) record16_##name
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX RecordSortContext
+#define SORT_LESS RECORD_LESS
+#define SORT_SWAP(ctx, i, j) swap_record_16(RECORD_AT(ctx, i), RECORD_AT(ctx, j))
+#define SORT_VALUE_T Record16
+#define SORT_GET(ctx, i) record16_get(RECORD_AT(ctx, i))
+#define SORT_SET(ctx, i, v) record16_set(RECORD_AT(ctx, i), (v))
+#define SORT_VALUE_LESS RECORD_VALUE_LESS
+#include "CSorttingTemplate.h"
+
+#define SORT_NAME(name) record32_##name
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX RecordSortContext
+#define SORT_LESS RECORD_LESS
+#define SORT_SWAP(ctx, i, j) swap_record_32(RECORD_AT(ctx, i), RECORD_AT(ctx, j))
+#define SORT_VALUE_T Record32
+#define SORT_GET(ctx, i) record32_get(RECORD_AT(ctx, i))
+#define SORT_SET(ctx, i, v) record32_set(RECORD_AT(ctx, i), (v))
+#define SORT_VALUE_LESS RECORD_VALUE_LESS
+#include "CSorttingTemplate.h"
+
+#define SORT_NAME(name) record_##name
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX RecordSortContext
+#define SORT_LESS RECORD_LESS
+#define SORT_SWAP(ctx, i, j) swap_record_bytes(RECORD_AT(ctx, i), RECORD_AT(ctx, j), (ctx)->element_size)
+#include "CSorttingTemplate.h"
+
+/**
+ * @brief Ordena registros según su tamaño, eligiendo el kernel de intercambio adecuado.
+ * @param ctx Contexto con el buffer, el paso y el comparador.
+ * @param count Número de registros.
+ */
+static void record_sort_dispatch(const RecordSortContext *ctx, size_t count)
+{
+    switch (ctx->element_size)
+    {
+    case 4:  record4_sort(ctx, 0, count);  break;
+    case 8:  record8_sort(ctx, 0, count);  break;
+    case 16: record16_sort(ctx, 0, count); break;
+    case 32: record32_sort(ctx, 0, count); break;
+    default: record_sort(ctx, 0, count);   break;
+    }
+}
+
+/**
+ * @brief Función pública de ordenación genérica
+ * @param it Puntero al iterador a ordenar
+ * @param compare Función de comparación para determinar el orden
+ *
+ * Esta función ordena los elementos del iterador usando pattern-defeating
+ * quicksort: QuickSort con pivote ninther y partición por bloques sin saltos
+ * dependientes de las comparaciones (BlockQuicksort), InsertionSort
+ * para subrangos pequeños y HeapSort si las particiones se desequilibran
+ * demasiado. Las entradas ordenadas, inversas o con muchas claves repetidas
+ * se resuelven en tiempo lineal o casi lineal; para entradas grandes, además,
+ * se muestrean antes para elegir estrategia (ver generic_sort_adaptive).
+ */
+void generic_sort(Iterator *it, CompareFunc compare)
+{
+    generic_sort_adaptive(it, compare);
+}
+
+/**
+ * @brief Coloca en la posición nth el elemento que le correspondería tras ordenar
+ * @param it Puntero al GenericArrayIterator
+ * @param nth Posición buscada (0 = el menor); si es >= size no se hace nada
+ * @param compare Función de comparación para determinar el orden
+ *
+ * Permuta la vista del iterador de modo que los elementos anteriores a nth
+ * no son mayores que él y los posteriores no son menores, sin ordenar ninguna
+ * de las dos partes. Tiempo lineal (introselect).
+ */
+void generic_nth_element(Iterator *it, size_t nth, CompareFunc compare)
+{
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops ||
+        nth >= ((GenericArrayIterator *)it->impl)->size)
+        return;
+
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return;
+
+    PointerSortContext ctx = { .elements = elements, .compare = compare };
+    pointer_select(&ctx, 0, nth, ((GenericArrayIterator *)it->impl)->size);
+
+    sort_finish(it);
+}
+
+/**
+ * @brief Ordena solo los k primeros elementos de la vista
+ * @param it Puntero al GenericArrayIterator
+ * @param k Número de elementos que deben quedar ordenados al principio
+ * @param compare Función de comparación para determinar el orden
+ *
+ * Tras la llamada, los k menores están ordenados al principio de la vista y el
+ * resto queda detrás en un orden no especificado. Coste O(n + k log k).
+ */
+void generic_partial_sort(Iterator *it, size_t k, CompareFunc compare)
+{
+    void **elements = sort_prepare_table(it);
+    if (!elements || k == 0)
+        return;
+
+    size_t n = ((GenericArrayIterator *)it->impl)->size;
+    PointerSortContext ctx = { .elements = elements, .compare = compare };
+    if (k < n)
+        pointer_select(&ctx, 0, k - 1, n);
+    else
+        k = n;
+    pointer_sort(&ctx, 0, k);
+
+    sort_finish(it);
+}
+
+/**
+ * @brief Obtiene los k menores elementos de un GenericArrayIterator, ordenados
+ * @param it Puntero al GenericArrayIterator (no se modifica)
+ * @param k Número de elementos buscados
+ * @param compare Función de comparación para determinar el orden
+ * @param out Array de al menos k punteros donde se escriben los elementos
+ * @return Número de elementos escritos (min(k, size)), 0 si el iterador no es válido
+ *
+ * Recorre la vista una vez manteniendo un heap máximo de k elementos, así que
+ * no modifica el iterador y solo usa la memoria de out. Para k pequeño el
+ * coste es prácticamente lineal: la mayoría de los elementos se descartan con
+ * una sola comparación contra la raíz del heap.
+ */
+size_t generic_top_k(Iterator *it, size_t k, CompareFunc compare, void **out)
+{
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops || !out || k == 0)
+        return 0;
+
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    size_t n = iter->size;
+    if (k > n)
+        k = n;
+
+    PointerSortContext ctx = { .elements = out, .compare = compare };
+    for (size_t i = 0; i < k; i++)
+        out[i] = generic_array_get(iter, i);
+    for (size_t i = k / 2; i-- > 0;)
+        pointer_sift_down(&ctx, 0, i, k);
+
+    for (size_t i = k; i < n; i++)
+    {
+        void *candidate = generic_array_get(iter, i);
+        if (compare(candidate, out[0]) < 0)
+        {
+            out[0] = candidate;
+            pointer_sift_down(&ctx, 0, 0, k);
+        }
+    }
+
+    // El heap máximo se ordena de forma ascendente
+    for (size_t i = k; i-- > 1;)
+    {
+        void *top = out[0];
+        out[0] = out[i];
+        out[i] = top;
+        pointer_sift_down(&ctx, 0, 0, i);
+    }
+    return k;
+}
+
+/**
+ * @brief Materializa la fuente de un SortedIterator (solo la primera vez).
+ * @return false si no hay elementos o no hubo memoria.
+ */
+static bool sorted_materialize(SortedIterator *iter)
+{
+    if (!iter->elements)
+    {
+        iter->elements = iterator_to_array(iter->source, &iter->size);
+        if (!iter->elements)
+        {
+            iter->size = 0;
+            return false;
+        }
+        iter->bad_allowed = log2_int(iter->size | 1) + 1;
+    }
+    return iter->index < iter->size;
+}
+
+/**
+ * @brief Deja en su posición definitiva el elemento de iter->index.
+ *
+ * Parte solo el tramo [index, cima de la pila) hasta que index es un pivote
+ * o cae en un tramo lo bastante pequeño para ordenarlo por inserción.
+ */
+static bool sorted_settle(SortedIterator *iter)
+{
+    PointerSortContext ctx = { .elements = iter->elements, .compare = iter->compare };
+    size_t begin = iter->index;
+
+    if (begin < iter->sorted_end)
+        return true;
+
+    for (;;)
+    {
+        size_t end = iter->pivot_count ? iter->pivots[iter->pivot_count - 1] : iter->size;
+
+        if (end == begin)
+        {
+            // index es un pivote: ya está en su sitio
+            iter->pivot_count--;
+            iter->sorted_end = begin + 1;
+            return true;
+        }
+
+        size_t size = end - begin;
+        if (size < SORT_INSERTION_THRESHOLD || iter->bad_allowed <= 0)
+        {
+            // Tramo pequeño, o demasiados pivotes malos: se ordena entero
+            pointer_sort(&ctx, begin, end);
+            iter->sorted_end = end;
+            return true;
+        }
+
+        pointer_choose_pivot(&ctx, begin, end);
+
+        // Si el pivote es igual al último elemento entregado, todos sus iguales
+        // van delante de una vez y quedan en su sitio definitivo
+        if (begin > 0 && !iter->compare(iter->elements[begin - 1], iter->elements[begin]))
+        {
+            iter->sorted_end = pointer_partition_left(&ctx, begin, end) + 1;
+            return true;
+        }
+
+        bool already_partitioned;
+        size_t pivot_pos = pointer_partition_right(&ctx, begin, end, &already_partitioned);
+        if (pivot_pos - begin < size / 8 || end - pivot_pos - 1 < size / 8)
+            iter->bad_allowed--;
+
+        if (iter->pivot_count == iter->pivot_capacity)
+        {
+            size_t grown = iter->pivot_capacity ? iter->pivot_capacity * 2 : 64;
+            size_t *tmp = realloc(iter->pivots, grown * sizeof(size_t));
+            if (!tmp)
+            {
+                pointer_sort(&ctx, begin, end);
+                iter->sorted_end = end;
+                return true;
+            }
+            iter->pivots = tmp;
+            iter->pivot_capacity = grown;
+        }
+        iter->pivots[iter->pivot_count++] = pivot_pos;
+    }
+}
+
+static void *sorted_next(Iterator *it)
+{
+    SortedIterator *iter = (SortedIterator *)it->impl;
+
+    if (!sorted_materialize(iter) || !sorted_settle(iter))
+    {
+        it->current = NULL;
+        return NULL;
+    }
+
+    it->current = iter->elements[iter->index++];
+    return it;
+}
+
+/**
+ * @brief Entrega de una vez los elementos que ya están en su sitio (al menos uno).
+ */
+static size_t sorted_next_batch(Iterator *it, void **out, size_t max)
+{
+    SortedIterator *iter = (SortedIterator *)it->impl;
+
+    if (max == 0)
+        return 0;
+    if (!sorted_materialize(iter) || !sorted_settle(iter))
+    {
+        it->current = NULL;
+        return 0;
+    }
+
+    size_t n = iter->sorted_end - iter->index;
+    if (n > max)
+        n = max;
+    memcpy(out, iter->elements + iter->index, n * sizeof(void *));
+    iter->index += n;
+    it->current = out[n - 1];
+    return n;
+}
+
+static bool sorted_equal(const Iterator *a, const Iterator *b)
+{
+    return a->impl == b->impl && a->current == b->current;
+}
+
+static void *sorted_deref(const Iterator *it)
+{
+    return it->current;
+}
+
+static bool sorted_stable_elements(const Iterator *it)
+{
+    return it != NULL;
+}
+
+static void sorted_destroy(Iterator *it)
+{
+    SortedIterator *iter = (SortedIterator *)it->impl;
+    iterator_destroy(&iter->source);
+    free(iter->elements);
+    free(iter->pivots);
+    free(iter);
+    it->impl = NULL;
+}
+
+/** Tabla de operaciones compartida por todos los SortedIterator. */
+static const IteratorOps sorted_iterator_ops = {
+    .next = sorted_next,
+    .equal = sorted_equal,
+    .deref = sorted_deref,
+    .destroy = sorted_destroy,
+    .next_batch = sorted_next_batch,
+    .stable_elements = sorted_stable_elements
+};
+
+/**
+ * @brief Crea un iterador que entrega los elementos de `src` en orden, ordenando bajo demanda
+ * @param src Iterador fuente; pasa a ser propiedad del nuevo iterador
+ * @param compare Función de comparación para determinar el orden
+ * @return Iterador de una sola pasada, o un iterador nulo si no hay memoria o
+ *         la fuente no tiene elementos estables (en ese caso `src` sigue
+ *         siendo del llamador)
+ *
+ * La fuente se consume entera en la primera llamada a next, así que sus
+ * elementos deben seguir siendo válidos después (iterator_stable_elements):
+ * un RangeIterator, por ejemplo, no sirve como fuente.
+ * El coste crece con el número de elementos que se consumen de verdad: leer
+ * los primeros k de n es O(n + k log k), y consumirlos todos es O(n log n).
+ * Se combina con filter_iterator y map_iterator como cualquier otro iterador.
+ */
+Iterator sorted_iterator(Iterator src, CompareFunc compare)
+{
+    if (!iterator_stable_elements(&src))
+        return (Iterator){0};
+
+    SortedIterator *impl = malloc(sizeof(SortedIterator));
+    if (!impl)
+        return (Iterator){0};
+
+    *impl = (SortedIterator){
+        .source = src,
+        .compare = compare
+    };
+
+    return (Iterator){
+        .ops = &sorted_iterator_ops,
+        .category = INPUT_ITERATOR,
+        .impl = impl,
+        .current = NULL
+    };
+}
+
+/**
+ * @brief Elemento de cabeza de la fuente i de un MergeIterator (NULL si está agotada).
+ */
+static inline void *merge_head(const MergeIterator *iter, size_t i)
+{
+    if (iter->positions[i] >= iter->lengths[i])
+        return NULL;
+    return iter->buffers[i * ITERATOR_BATCH_SIZE + iter->positions[i]];
+}
+
+/**
+ * @brief Lee el siguiente lote de la fuente i.
+ */
+static void merge_fill(MergeIterator *iter, size_t i)
+{
+    iter->positions[i] = 0;
+    iter->lengths[i] = iterator_next_batch(&iter->sources[i], iter->buffers + i * ITERATOR_BATCH_SIZE,
+                                           ITERATOR_BATCH_SIZE);
+}
+
+/**
+ * @brief Indica si la fuente a gana a la b en el torneo.
+ *
+ * Una fuente agotada pierde siempre; a igualdad de claves gana la de menor
+ * índice, así que la fusión es estable respecto al orden de las fuentes.
+ */
+static inline bool merge_beats(const MergeIterator *iter, size_t a, size_t b)
+{
+    void *x = merge_head(iter, a);
+    void *y = merge_head(iter, b);
+    if (!x)
+        return false;
+    if (!y)
+        return true;
+    int c = iter->compare(x, y);
+    return c < 0 || (c == 0 && a < b);
+}
+
+/**
+ * @brief Juega el subárbol del nodo `node` y devuelve su ganadora.
+ *
+ * Las hojas son los nodos [count, 2 * count): la hoja de la fuente i es count + i.
+ */
+static size_t merge_build(MergeIterator *iter, size_t node)
+{
+    if (node >= iter->count)
+        return node - iter->count;
+
+    size_t left = merge_build(iter, 2 * node);
+    size_t right = merge_build(iter, 2 * node + 1);
+    if (merge_beats(iter, left, right))
+    {
+        iter->tree[node] = right;
+        return left;
+    }
+    iter->tree[node] = left;
+    return right;
+}
+
+/**
+ * @brief Avanza la fuente ganadora y rejuega su camino hasta la raíz.
+ */
+static void merge_replay(MergeIterator *iter)
+{
+    size_t winner = iter->tree[0];
+
+    if (++iter->positions[winner] >= iter->lengths[winner])
+        merge_fill(iter, winner);
+
+    for (size_t node = (iter->count + winner) / 2; node > 0; node /= 2)
+    {
+        if (merge_beats(iter, iter->tree[node], winner))
+        {
+            size_t loser = winner;
+            winner = iter->tree[node];
+            iter->tree[node] = loser;
+        }
+    }
+    iter->tree[0] = winner;
+}
+
+/**
+ * @brief Deja en la raíz del torneo la fuente con el siguiente elemento a entregar.
+ * @return false si todas las fuentes están agotadas.
+ */
+static bool merge_settle(MergeIterator *iter)
+{
+    if (iter->count == 0)
+        return false;
+
+    if (!iter->started)
+    {
+        for (size_t i = 0; i < iter->count; i++)
+            merge_fill(iter, i);
+        iter->tree[0] = merge_build(iter, 1);
+        iter->started = true;
+    }
+    else if (iter->pending)
+        merge_replay(iter);
+
+    iter->pending = false;
+    return merge_head(iter, iter->tree[0]) != NULL;
+}
+
+static void *merge_next(Iterator *it)
+{
+    MergeIterator *iter = (MergeIterator *)it->impl;
+
+    if (!merge_settle(iter))
+    {
+        it->current = NULL;
+        return NULL;
+    }
+
+    // La ganadora se avanza en la siguiente llamada, así el elemento entregado sigue siendo válido
+    it->current = merge_head(iter, iter->tree[0]);
+    iter->pending = true;
+    return it;
+}
+
+/**
+ * @brief Entrega hasta `max` elementos fusionados de una vez.
+ *
+ * El lote se corta antes de tener que releer una fuente que ya aportó
+ * elementos, porque leer su siguiente lote puede invalidarlos (por ejemplo
+ * en un RangeIterator).
+ */
+static size_t merge_next_batch(Iterator *it, void **out, size_t max)
+{
+    MergeIterator *iter = (MergeIterator *)it->impl;
+    size_t n = 0;
+
+    while (n < max)
+    {
+        if (n > 0)
+        {
+            size_t winner = iter->tree[0];
+            if (iter->positions[winner] + 1 >= iter->lengths[winner])
+                break;
+        }
+        if (!merge_settle(iter))
+            break;
+        out[n++] = merge_head(iter, iter->tree[0]);
+        iter->pending = true;
+    }
+
+    if (max > 0)
+        it->current = n > 0 ? out[n - 1] : NULL;
+    return n;
+}
+
+static bool merge_equal(const Iterator *a, const Iterator *b)
+{
+    return a->impl == b->impl && a->current == b->current;
+}
+
+static void *merge_deref(const Iterator *it)
+{
+    return it->current;
+}
+
+/**
+ * @brief Los elementos fusionados son los de las fuentes: estables si lo son todas.
+ */
+static bool merge_stable_elements(const Iterator *it)
+{
+    const MergeIterator *iter = (const MergeIterator *)it->impl;
+    for (size_t i = 0; i < iter->count; i++)
+        if (!iterator_stable_elements(&iter->sources[i]))
+            return false;
+    return true;
+}
+
+static void merge_destroy(Iterator *it)
+{
+    MergeIterator *iter = (MergeIterator *)it->impl;
+    for (size_t i = 0; i < iter->count; i++)
+        iterator_destroy(&iter->sources[i]);
+    free(iter->sources);
+    free(iter->buffers);
+    free(iter->positions);
+    free(iter->lengths);
+    free(iter->tree);
+    free(iter);
+    it->impl = NULL;
+}
+
+/** Tabla de operaciones compartida por todos los MergeIterator. */
+static const IteratorOps merge_iterator_ops = {
+    .next = merge_next,
+    .equal = merge_equal,
+    .deref = merge_deref,
+    .destroy = merge_destroy,
+    .next_batch = merge_next_batch,
+    .stable_elements = merge_stable_elements
+};
+
+/**
+ * @brief Crea un iterador que fusiona k iteradores ya ordenados
+ * @param sources Array de k iteradores ordenados según `compare`; pasan a ser
+ *        propiedad del nuevo iterador (el array en sí se copia)
+ * @param k Número de iteradores en `sources`
+ * @param compare Función de comparación con la que están ordenadas las fuentes
+ * @return Iterador de una sola pasada, o un iterador nulo si no hay memoria
+ *         (en ese caso las fuentes siguen siendo del llamador)
+ *
+ * Entrega los elementos de todas las fuentes en orden global sin copiarlos a
+ * ningún array: fusionar n elementos en total cuesta O(n log k) comparaciones
+ * y O(k) memoria. Con claves iguales sale antes el elemento de la fuente de
+ * menor índice. Como con multi_zip_iterators, al destruirlo se destruyen
+ * también las fuentes.
+ */
+Iterator merge_iterators(Iterator *sources, size_t k, CompareFunc compare)
+{
+    MergeIterator *impl = malloc(sizeof(MergeIterator));
+    if (!impl)
+        return (Iterator){0};
+
+    size_t slots = k ? k : 1;
+    Iterator *owned_sources = malloc(slots * sizeof(Iterator));
+    void **buffers = malloc(slots * ITERATOR_BATCH_SIZE * sizeof(void *));
+    size_t *positions = malloc(slots * sizeof(size_t));
+    size_t *lengths = malloc(slots * sizeof(size_t));
+    size_t *tree = malloc(slots * sizeof(size_t));
+
+    if (!owned_sources || !buffers || !positions || !lengths || !tree)
+    {
+        free(owned_sources);
+        free(buffers);
+        free(positions);
+        free(lengths);
+        free(tree);
+        free(impl);
+        return (Iterator){0};
+    }
+
+    for (size_t i = 0; i < k; i++)
+        owned_sources[i] = sources[i];
+
+    *impl = (MergeIterator){
+        .sources = owned_sources,
+        .count = k,
+        .compare = compare,
+        .buffers = buffers,
+        .positions = positions,
+        .lengths = lengths,
+        .tree = tree
+    };
+
+    return (Iterator){
+        .ops = &merge_iterator_ops,
+        .category = INPUT_ITERATOR,
+        .impl = impl,
+        .current = NULL
+    };
+}
+
+/**
+ * @brief Ordena un array de registros directamente en su buffer
+ * @param base Puntero al primer registro
+ * @param count Número de registros
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ *
+ * A diferencia de generic_sort, mueve los propios registros: no necesita tabla
+ * de punteros y los recorridos posteriores del array siguen siendo secuenciales.
+ * Los tamaños de 4, 8, 16 y 32 bytes usan intercambios especializados; el
+ * resto usa memcpy por bloques.
+ */
+void generic_sort_records(void *base, size_t count, size_t element_size, CompareFunc compare)
+{
+    if (!base || count <= 1 || element_size == 0)
+        return;
+
+    RecordSortContext ctx = {
+        .base = (char *)base,
+        .stride = element_size,
+        .element_size = element_size,
+        .compare = compare
+    };
+    record_sort_dispatch(&ctx, count);
+}
+
+/**
+ * @brief Ordena en su sitio el buffer original de un GenericArrayIterator
+ * @param it Puntero al iterador cuyo array se va a ordenar
+ * @param compare Función de comparación para determinar el orden
+ *
+ * Los registros se reordenan dentro del array del usuario (respetando el
+ * stride del iterador). Si el iterador tenía una tabla de punteros se libera,
+ * ya que a partir de aquí el orden del buffer es el orden de iteración.
+ */
+void generic_sort_inplace(Iterator *it, CompareFunc compare)
+{
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops)
+        return;
+
+    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+
+    free(iter->elements);
+    iter->elements = NULL;
+
+    if (iter->size > 1)
+    {
+        RecordSortContext ctx = {
+            .base = iter->base,
+            .stride = iter->stride,
+            .element_size = iter->element_size,
+            .compare = compare
+        };
+        record_sort_dispatch(&ctx, iter->size);
+    }
+
+    sort_finish(it);
+}
+
+/*
+ * Ordenación paralela: cada hilo ordena un bloque contiguo con pdqsort y los
+ * bloques se fusionan por rondas. En cada ronda la salida se reparte a partes
+ * iguales entre los hilos, y cada uno localiza con búsqueda binaria (co-rank)
+ * el tramo de las dos entradas que le corresponde, de modo que también la
+ * última fusión, la de todo el array, se reparte entre todos los hilos.
+ */
+
+static size_t parallel_sort_threshold = PARALLEL_SORT_THRESHOLD;
+
+/**
+ * @brief Cambia el tamaño mínimo a partir del cual se ordena en paralelo
+ * @param min_elements Número mínimo de elementos (0 restaura el valor por defecto)
+ */
+void generic_parallel_sort_set_threshold(size_t min_elements)
+{
+    parallel_sort_threshold = min_elements ? min_elements : PARALLEL_SORT_THRESHOLD;
+}
+
+/**
+ * @struct SortLayout
+ * @brief Disposición en memoria de los elementos que se fusionan.
+ *
+ * Con `indirect` cada elemento empieza por un puntero (tabla de un
+ * GenericArrayIterator o ArgsortEntry) y se compara lo apuntado; si no, se
+ * compara el propio registro.
+ */
+typedef struct SortLayout {
+    char *base;          /**< Primer elemento. */
+    size_t esize;        /**< Tamaño de cada elemento en bytes. */
+    CompareFunc compare; /**< Función de comparación. */
+    bool indirect;       /**< true si los elementos son punteros a los datos a comparar. */
+} SortLayout;
+
+static inline bool layout_less(const SortLayout *layout, const char *a, const char *b)
+{
+    if (layout->indirect)
+        return layout->compare(*(void *const *)a, *(void *const *)b) < 0;
+    return layout->compare(a, b) < 0;
+}
+
+static inline void layout_copy(const SortLayout *layout, char *dst, const char *src, size_t count)
+{
+    memcpy(dst, src, count * layout->esize);
+}
+
+/**
+ * @brief Número de elementos que aporta A a las `d` primeras posiciones de la fusión estable de A y B.
+ */
+static size_t merge_corank(const SortLayout *layout, size_t d,
+                           const char *a, size_t m, const char *b, size_t k)
+{
+    size_t es = layout->esize;
+    size_t lo = d > k ? d - k : 0;
+    size_t hi = d < m ? d : m;
+
+    while (lo < hi)
+    {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = d - i;
+        // i < m y j > 0 dentro del intervalo; si A[i] <= B[j-1], A[i] sale
+        // antes que B[j-1] y hay que tomar más elementos de A
+        if (!layout_less(layout, b + (j - 1) * es, a + i * es))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+/**
+ * @brief Fusión estable de A[0, m) y B[0, k) en out (los iguales de A van primero).
+ */
+static void merge_runs(const SortLayout *layout, char *out,
+                       const char *a, size_t m, const char *b, size_t k)
+{
+    size_t es = layout->esize;
+    const char *a_end = a + m * es;
+    const char *b_end = b + k * es;
+
+    while (a < a_end && b < b_end)
+    {
+        if (layout_less(layout, b, a))
+        {
+            memcpy(out, b, es);
+            b += es;
+        }
+        else
+        {
+            memcpy(out, a, es);
+            a += es;
+        }
+        out += es;
+    }
+    if (a < a_end)
+        memcpy(out, a, (size_t)(a_end - a));
+    if (b < b_end)
+        memcpy(out, b, (size_t)(b_end - b));
+}
+
+/**
+ * @struct ParallelSortTask
+ * @brief Trabajo de un hilo: ordenar un bloque o producir un tramo de una ronda de fusión.
+ */
+typedef struct ParallelSortTask {
+    const SortLayout *layout; /**< Elementos a ordenar. */
+    const char *src;          /**< Entrada de la ronda de fusión. */
+    char *dst;                /**< Salida de la ronda de fusión. */
+    const size_t *bounds;     /**< Límites de los bloques ordenados (runs + 1 entradas). */
+    size_t runs;              /**< Número de bloques ordenados. */
+    size_t begin;             /**< Inicio del bloque o del tramo de salida. */
+    size_t end;               /**< Fin del bloque o del tramo de salida. */
+} ParallelSortTask;
+
+static void *parallel_sort_chunk_worker(void *arg)
+{
+    ParallelSortTask *task = (ParallelSortTask *)arg;
+    const SortLayout *layout = task->layout;
+
+    if (layout->indirect && layout->esize == sizeof(ArgsortEntry))
+    {
+        ArgsortContext ctx = { .entries = (ArgsortEntry *)layout->base, .compare = layout->compare };
+        argsort_sort(&ctx, task->begin, task->end);
+    }
+    else if (layout->indirect)
+    {
+        PointerSortContext ctx = { .elements = (void **)layout->base, .compare = layout->compare };
+        pointer_sort(&ctx, task->begin, task->end);
+    }
+    else
+    {
+        RecordSortContext ctx = {
+            .base = layout->base + task->begin * layout->esize,
+            .stride = layout->esize,
+            .element_size = layout->esize,
+            .compare = layout->compare
+        };
+        record_sort_dispatch(&ctx, task->end - task->begin);
+    }
+    return NULL;
+}
+
+static void *parallel_merge_worker(void *arg)
+{
+    ParallelSortTask *task = (ParallelSortTask *)arg;
+    const SortLayout *layout = task->layout;
+    size_t es = layout->esize;
+
+    for (size_t p = 0; 2 * p < task->runs; p++)
+    {
+        size_t a0 = task->bounds[2 * p];
+        size_t a1 = task->bounds[2 * p + 1 < task->runs ? 2 * p + 1 : task->runs];
+        size_t b1 = task->bounds[2 * p + 2 < task->runs ? 2 * p + 2 : task->runs];
+
+        size_t lo = a0 > task->begin ? a0 : task->begin;
+        size_t hi = b1 < task->end ? b1 : task->end;
+        if (lo >= hi)
+            continue;
+
+        const char *a = task->src + a0 * es;
+        const char *b = task->src + a1 * es;
+        size_t m = a1 - a0, k = b1 - a1;
+        size_t d0 = lo - a0, d1 = hi - a0;
+        size_t i0 = merge_corank(layout, d0, a, m, b, k);
+        size_t i1 = merge_corank(layout, d1, a, m, b, k);
+
+        merge_runs(layout, task->dst + lo * es, a + i0 * es, i1 - i0,
+                   b + (d0 - i0) * es, (d1 - i1) - (d0 - i0));
+    }
+    return NULL;
+}
+
+/**
+ * @brief Ejecuta `count` tareas, una por hilo (la primera en el hilo llamante).
+ *
+ * Si no se puede crear un hilo, su tarea se ejecuta en el hilo llamante.
+ */
+static void parallel_run(void *(*worker)(void *), ParallelSortTask *tasks, size_t count)
+{
+    pthread_t *threads = malloc(count * sizeof(pthread_t));
+    bool *started = calloc(count, sizeof(bool));
+
+    for (size_t t = 1; t < count; t++)
+    {
+        if (threads && started)
+            started[t] = pthread_create(&threads[t], NULL, worker, &tasks[t]) == 0;
+        if (!started || !started[t])
+            worker(&tasks[t]);
+    }
+    worker(&tasks[0]);
+
+    for (size_t t = 1; t < count && started; t++)
+        if (started[t])
+            pthread_join(threads[t], NULL);
+
+    free(started);
+    free(threads);
+}
+
+/**
+ * @brief Número de procesadores disponibles (1 si no se puede determinar).
+ */
+static size_t available_cpus(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#endif
+}
+
+/**
+ * @brief Núcleo de la ordenación paralela sobre una SortLayout de `n` elementos.
+ * @return false si no se pudo ordenar en paralelo (el llamador ordena en secuencial).
+ */
+static bool parallel_sort_layout(const SortLayout *layout, size_t n, size_t threads)
+{
+    if (threads == 0)
+        threads = available_cpus();
+    // Bloques de al menos la mitad del umbral para que compense crear hilos
+    size_t max_threads = n / (parallel_sort_threshold / 2 + 1);
+    if (threads > max_threads)
+        threads = max_threads;
+    if (threads < 2 || n < parallel_sort_threshold)
+        return false;
+
+    size_t es = layout->esize;
+    char *scratch = malloc(n * es);
+    size_t *bounds = malloc((threads + 1) * sizeof(size_t));
+    ParallelSortTask *tasks = malloc(threads * sizeof(ParallelSortTask));
+    if (!scratch || !bounds || !tasks)
+    {
+        free(scratch);
+        free(bounds);
+        free(tasks);
+        return false;
+    }
+
+    for (size_t t = 0; t <= threads; t++)
+        bounds[t] = n / threads * t + (t < n % threads ? t : n % threads);
+
+    // Fase 1: ordenar cada bloque
+    for (size_t t = 0; t < threads; t++)
+        tasks[t] = (ParallelSortTask){ .layout = layout, .begin = bounds[t], .end = bounds[t + 1] };
+    parallel_run(parallel_sort_chunk_worker, tasks, threads);
+
+    // Fase 2: fusionar por rondas, alternando entre el array y el buffer auxiliar
+    char *src = layout->base;
+    char *dst = scratch;
+    size_t runs = threads;
+    while (runs > 1)
+    {
+        for (size_t t = 0; t < threads; t++)
+            tasks[t] = (ParallelSortTask){
+                .layout = layout, .src = src, .dst = dst, .bounds = bounds, .runs = runs,
+                .begin = n / threads * t, .end = (t + 1 == threads) ? n : n / threads * (t + 1)
+            };
+        parallel_run(parallel_merge_worker, tasks, threads);
+
+        size_t merged = 0;
+        for (size_t r = 0; r < runs; r += 2)
+            bounds[++merged] = bounds[r + 2 <= runs ? r + 2 : runs];
+        runs = merged;
+
+        char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != layout->base)
+        layout_copy(layout, layout->base, src, n);
+
+    free(tasks);
+    free(bounds);
+    free(scratch);
+    return true;
+}
+
+/**
+ * @brief Ordena en paralelo la vista de un GenericArrayIterator
+ * @param it Puntero al iterador a ordenar
+ * @param compare Función de comparación para determinar el orden
+ * @param threads Número de hilos (0 = uno por procesador disponible)
+ *
+ * Igual que generic_sort permuta la tabla de punteros. Por debajo del umbral
+ * configurado (generic_parallel_sort_set_threshold) usa el camino secuencial.
+ * Necesita un buffer auxiliar del tamaño de la tabla.
+ */
+void generic_parallel_sort(Iterator *it, CompareFunc compare, size_t threads)
+{
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return;
+
+    size_t n = ((GenericArrayIterator *)it->impl)->size;
+    SortLayout layout = { .base = (char *)elements, .esize = sizeof(void *), .compare = compare, .indirect = true };
+    if (!parallel_sort_layout(&layout, n, threads))
+    {
+        PointerSortContext ctx = { .elements = elements, .compare = compare };
+        pointer_sort(&ctx, 0, n);
+    }
+
+    sort_finish(it);
+}
+
+/**
+ * @brief Ordena en paralelo un array de registros en su buffer
+ * @param base Puntero al primer registro
+ * @param count Número de registros
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ * @param threads Número de hilos (0 = uno por procesador disponible)
+ *
+ * Equivalente paralelo de generic_sort_records. Necesita un buffer auxiliar
+ * de count * element_size bytes.
+ */
+void generic_parallel_sort_records(void *base, size_t count, size_t element_size,
+                                   CompareFunc compare, size_t threads)
+{
+    if (!base || count <= 1 || element_size == 0)
+        return;
+
+    SortLayout layout = { .base = (char *)base, .esize = element_size, .compare = compare, .indirect = false };
+    if (!parallel_sort_layout(&layout, count, threads))
+        generic_sort_records(base, count, element_size, compare);
+}
+
+/*
+ * Ordenación estable adaptativa (estilo Timsort): detecta los tramos ya
+ * ordenados de la entrada (invirtiendo los estrictamente descendentes),
+ * alarga los cortos hasta min_run con inserción binaria y los fusiona con
+ * una pila de tramos que mantiene las invariantes de Timsort. Las fusiones
+ * pasan a modo galope cuando un lado gana muchas veces seguidas, así que una
+ * entrada ordenada o casi ordenada se resuelve en tiempo casi lineal.
+ */
+
+#define STABLE_MIN_GALLOP 7
+#define STABLE_MAX_RUNS 85 /**< Suficiente para 2^64 elementos con las invariantes de Timsort. */
+
+/**
+ * @struct StableRun
+ * @brief Tramo ordenado pendiente de fusionar.
+ */
+typedef struct StableRun {
+    size_t begin; /**< Índice del primer elemento. */
+    size_t len;   /**< Número de elementos. */
+} StableRun;
+
+/**
+ * @struct StableMergeState
+ * @brief Estado de una ordenación estable.
+ */
+typedef struct StableMergeState {
+    const SortLayout *layout;          /**< Elementos a ordenar. */
+    char *tmp;                         /**< Buffer auxiliar de al menos n / 2 elementos. */
+    size_t min_gallop;                 /**< Umbral adaptativo para entrar en modo galope. */
+    size_t run_count;                  /**< Tramos en la pila. */
+    StableRun runs[STABLE_MAX_RUNS];   /**< Pila de tramos pendientes. */
+} StableMergeState;
+
+/**
+ * @brief Tamaño mínimo de tramo: entre 32 y 64, de forma que n / min_run sea
+ *        una potencia de dos o algo menos.
+ */
+static size_t stable_min_run(size_t n)
+{
+    size_t r = 0;
+    while (n >= 64)
+    {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/**
+ * @brief Busca con galope desde `hint` la posición de `key` en el tramo ordenado a[0, n)
+ * @param right false: primera posición con a[i] >= key; true: primera con a[i] > key
+ */
+static size_t stable_gallop(const SortLayout *layout, const char *key,
+                            const char *a, size_t n, size_t hint, bool right)
+{
+    size_t es = layout->esize;
+#define GALLOP_BEFORE(elem) (right ? !layout_less(layout, key, (elem)) : layout_less(layout, (elem), key))
+    size_t lo, hi;
+    size_t last = 0, ofs = 1;
+
+    if (GALLOP_BEFORE(a + hint * es))
+    {
+        // El resultado está a la derecha de hint
+        size_t max_ofs = n - hint;
+        while (ofs < max_ofs && GALLOP_BEFORE(a + (hint + ofs) * es))
+        {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs)
+            ofs = max_ofs;
+        lo = hint + last + 1;
+        hi = hint + ofs;
+    }
+    else
+    {
+        // El resultado está en hint o a su izquierda
+        size_t max_ofs = hint + 1;
+        while (ofs < max_ofs && !GALLOP_BEFORE(a + (hint - ofs) * es))
+        {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs)
+            ofs = max_ofs;
+        lo = hint + 1 - ofs;
+        hi = hint - last;
+    }
+
+    while (lo < hi)
+    {
+        size_t m = lo + (hi - lo) / 2;
+        if (GALLOP_BEFORE(a + m * es))
+            lo = m + 1;
+        else
+            hi = m;
+    }
+#undef GALLOP_BEFORE
+    return hi;
+}
+
+/**
+ * @brief Fusiona A = base[0, na) y B = base[na, na + nb) copiando A (el menor) al buffer auxiliar.
+ *
+ * Requiere B[0] < A[0] y A[na - 1] > B[nb - 1] (garantizado por stable_merge_at).
+ */
+static void stable_merge_lo(StableMergeState *ms, char *base, size_t na, size_t nb)
+{
+    const SortLayout *layout = ms->layout;
+    size_t es = layout->esize;
+    size_t min_gallop = ms->min_gallop;
+    char *a = ms->tmp;
+    char *b = base + na * es;
+    char *dest = base;
+
+    memcpy(a, base, na * es);
+    memcpy(dest, b, es);
+    dest += es;
+    b += es;
+    if (--nb == 0)
+        goto succeed;
+    if (na == 1)
+        goto copy_b;
+
+    for (;;)
+    {
+        size_t a_count = 0, b_count = 0;
+
+        // Fusión uno a uno hasta que un lado gane min_gallop veces seguidas
+        for (;;)
+        {
+            if (layout_less(layout, b, a))
+            {
+                memcpy(dest, b, es);
+                dest += es;
+                b += es;
+                a_count = 0;
+                if (--nb == 0)
+                    goto succeed;
+                if (++b_count >= min_gallop)
+                    break;
+            }
+            else
+            {
+                memcpy(dest, a, es);
+                dest += es;
+                a += es;
+                b_count = 0;
+                if (--na == 1)
+                    goto copy_b;
+                if (++a_count >= min_gallop)
+                    break;
+            }
+        }
+
+        // Modo galope: copiar bloques mientras sigan saliendo largos
+        min_gallop++;
+        do
+        {
+            min_gallop -= min_gallop > 1;
+
+            a_count = stable_gallop(layout, b, a, na, 0, true);
+            if (a_count)
+            {
+                memcpy(dest, a, a_count * es);
+                dest += a_count * es;
+                a += a_count * es;
+                na -= a_count;
+                if (na == 1)
+                    goto copy_b;
+                if (na == 0)
+                    goto succeed;
+            }
+            memcpy(dest, b, es);
+            dest += es;
+            b += es;
+            if (--nb == 0)
+                goto succeed;
+
+            b_count = stable_gallop(layout, a, b, nb, 0, false);
+            if (b_count)
+            {
+                memmove(dest, b, b_count * es);
+                dest += b_count * es;
+                b += b_count * es;
+                nb -= b_count;
+                if (nb == 0)
+                    goto succeed;
+            }
+            memcpy(dest, a, es);
+            dest += es;
+            a += es;
+            if (--na == 1)
+                goto copy_b;
+        } while (a_count >= STABLE_MIN_GALLOP || b_count >= STABLE_MIN_GALLOP);
+        min_gallop++;
+    }
+
+succeed:
+    if (na)
+        memcpy(dest, a, na * es);
+    ms->min_gallop = min_gallop;
+    return;
+
+copy_b:
+    // Queda un solo elemento de A, que va detrás de todo lo que queda de B
+    memmove(dest, b, nb * es);
+    memcpy(dest + nb * es, a, es);
+    ms->min_gallop = min_gallop;
+}
+
+/**
+ * @brief Fusiona A = base[0, na) y B = base[na, na + nb) desde el final copiando B (el menor) al buffer auxiliar.
+ *
+ * Mismos requisitos que stable_merge_lo. Se trabaja con índices: el destino
+ * siempre es base[na + nb - 1].
+ */
+static void stable_merge_hi(StableMergeState *ms, char *base, size_t na, size_t nb)
+{
+    const SortLayout *layout = ms->layout;
+    size_t es = layout->esize;
+    size_t min_gallop = ms->min_gallop;
+    char *b = ms->tmp;
+    char *a = base;
+
+    memcpy(b, base + na * es, nb * es);
+    memcpy(base + (na + nb - 1) * es, a + (na - 1) * es, es);
+    if (--na == 0)
+        goto succeed;
+    if (nb == 1)
+        goto copy_a;
+
+    for (;;)
+    {
+        size_t a_count = 0, b_count = 0;
+
+        for (;;)
+        {
+            if (layout_less(layout, b + (nb - 1) * es, a + (na - 1) * es))
+            {
+                memcpy(base + (na + nb - 1) * es, a + (na - 1) * es, es);
+                b_count = 0;
+                if (--na == 0)
+                    goto succeed;
+                if (++a_count >= min_gallop)
+                    break;
+            }
+            else
+            {
+                memcpy(base + (na + nb - 1) * es, b + (nb - 1) * es, es);
+                a_count = 0;
+                if (--nb == 1)
+                    goto copy_a;
+                if (++b_count >= min_gallop)
+                    break;
+            }
+        }
+
+        min_gallop++;
+        do
+        {
+            min_gallop -= min_gallop > 1;
+
+            a_count = na - stable_gallop(layout, b + (nb - 1) * es, a, na, na - 1, true);
+            if (a_count)
+            {
+                memmove(base + (na + nb - a_count) * es, a + (na - a_count) * es, a_count * es);
+                na -= a_count;
+                if (na == 0)
+                    goto succeed;
+            }
+            memcpy(base + (na + nb - 1) * es, b + (nb - 1) * es, es);
+            if (--nb == 1)
+                goto copy_a;
+
+            b_count = nb - stable_gallop(layout, a + (na - 1) * es, b, nb, nb - 1, false);
+            if (b_count)
+            {
+                memcpy(base + (na + nb - b_count) * es, b + (nb - b_count) * es, b_count * es);
+                nb -= b_count;
+                if (nb == 1)
+                    goto copy_a;
+                if (nb == 0)
+                    goto succeed;
+            }
+            memcpy(base + (na + nb - 1) * es, a + (na - 1) * es, es);
+            if (--na == 0)
+                goto succeed;
+        } while (a_count >= STABLE_MIN_GALLOP || b_count >= STABLE_MIN_GALLOP);
+        min_gallop++;
+    }
+
+succeed:
+    if (nb)
+        memcpy(base, b, nb * es);
+    ms->min_gallop = min_gallop;
+    return;
+
+copy_a:
+    // Queda un solo elemento de B, que va delante de todo lo que queda de A
+    memmove(base + es, a, na * es);
+    memcpy(base, b, es);
+    ms->min_gallop = min_gallop;
+}
+
+/**
+ * @brief Fusiona los tramos i e i + 1 de la pila.
+ */
+static void stable_merge_at(StableMergeState *ms, size_t i)
+{
+    const SortLayout *layout = ms->layout;
+    size_t es = layout->esize;
+    char *a = layout->base + ms->runs[i].begin * es;
+    size_t na = ms->runs[i].len;
+    char *b = layout->base + ms->runs[i + 1].begin * es;
+    size_t nb = ms->runs[i + 1].len;
+
+    ms->runs[i].len = na + nb;
+    if (i + 3 == ms->run_count)
+        ms->runs[i + 1] = ms->runs[i + 2];
+    ms->run_count--;
+
+    // Los elementos de A que no superan a B[0] ya están en su sitio
+    size_t k = stable_gallop(layout, b, a, na, 0, true);
+    a += k * es;
+    na -= k;
+    if (na == 0)
+        return;
+
+    // Y también los de B que no quedan por debajo del último de A
+    nb = stable_gallop(layout, a + (na - 1) * es, b, nb, nb - 1, false);
+    if (nb == 0)
+        return;
+
+    if (na <= nb)
+        stable_merge_lo(ms, a, na, nb);
+    else
+        stable_merge_hi(ms, a, na, nb);
+}
+
+/**
+ * @brief Restablece las invariantes de la pila de tramos fusionando los necesarios.
+ */
+static void stable_merge_collapse(StableMergeState *ms)
+{
+    StableRun *p = ms->runs;
+
+    while (ms->run_count > 1)
+    {
+        size_t k = ms->run_count - 2;
+        if ((k > 0 && p[k - 1].len <= p[k].len + p[k + 1].len) ||
+            (k > 1 && p[k - 2].len <= p[k - 1].len + p[k].len))
+        {
+            if (p[k - 1].len < p[k + 1].len)
+                k--;
+            stable_merge_at(ms, k);
+        }
+        else if (p[k].len <= p[k + 1].len)
+            stable_merge_at(ms, k);
+        else
+            break;
+    }
+}
+
+/**
+ * @brief Longitud del tramo ordenado que empieza en a[0]; si es estrictamente
+ *        descendente lo invierte (sin romper la estabilidad).
+ */
+static size_t stable_count_run(const SortLayout *layout, char *a, size_t n)
+{
+    size_t es = layout->esize;
+    size_t i = 1;
+
+    if (n == 1)
+        return 1;
+    if (layout_less(layout, a + es, a))
+    {
+        while (++i < n && layout_less(layout, a + i * es, a + (i - 1) * es))
+            ;
+        for (size_t lo = 0, hi = i - 1; lo < hi; lo++, hi--)
+            swap_record_bytes(a + lo * es, a + hi * es, es);
+    }
+    else
+    {
+        while (++i < n && !layout_less(layout, a + i * es, a + (i - 1) * es))
+            ;
+    }
+    return i;
+}
+
+/**
+ * @brief Inserción binaria estable de a[sorted, n) sobre el prefijo ordenado a[0, sorted).
+ */
+static void stable_binary_insertion(const SortLayout *layout, char *tmp, char *a, size_t sorted, size_t n)
+{
+    size_t es = layout->esize;
+
+    for (size_t i = sorted; i < n; i++)
+    {
+        char *pivot = a + i * es;
+        size_t lo = 0, hi = i;
+        while (lo < hi)
+        {
+            size_t m = lo + (hi - lo) / 2;
+            if (layout_less(layout, pivot, a + m * es))
+                hi = m;
+            else
+                lo = m + 1;
+        }
+        if (lo == i)
+            continue;
+        memcpy(tmp, pivot, es);
+        memmove(a + (lo + 1) * es, a + lo * es, (i - lo) * es);
+        memcpy(a + lo * es, tmp, es);
+    }
+}
+
+/**
+ * @brief Núcleo de la ordenación estable sobre una SortLayout de `n` elementos.
+ * @return false si hacía falta reservar el buffer auxiliar y no se pudo.
+ */
+static bool stable_sort_layout(const SortLayout *layout, size_t n, void *scratch, size_t scratch_size)
+{
+    if (n < 2)
+        return true;
+
+    size_t es = layout->esize;
+    size_t needed = generic_stable_sort_scratch_size(n, es);
+    char *owned = NULL;
+    if (!scratch || scratch_size < needed)
+    {
+        owned = malloc(needed);
+        if (!owned)
+            return false;
+        scratch = owned;
+    }
+
+    StableMergeState ms = { .layout = layout, .tmp = scratch, .min_gallop = STABLE_MIN_GALLOP, .run_count = 0 };
+    size_t min_run = stable_min_run(n);
+
+    for (size_t lo = 0; lo < n;)
+    {
+        char *run = layout->base + lo * es;
+        size_t remaining = n - lo;
+        size_t len = stable_count_run(layout, run, remaining);
+
+        if (len < min_run)
+        {
+            size_t forced = remaining < min_run ? remaining : min_run;
+            stable_binary_insertion(layout, ms.tmp, run, len, forced);
+            len = forced;
+        }
+
+        ms.runs[ms.run_count++] = (StableRun){ .begin = lo, .len = len };
+        stable_merge_collapse(&ms);
+        lo += len;
+    }
+
+    // Fusionar lo que quede en la pila
+    while (ms.run_count > 1)
+    {
+        size_t k = ms.run_count - 2;
+        if (k > 0 && ms.runs[k - 1].len < ms.runs[k + 1].len)
+            k--;
+        stable_merge_at(&ms, k);
+    }
+
+    free(owned);
+    return true;
+}
+
+/**
+ * @brief Bytes de buffer auxiliar que necesita una ordenación estable sin reservar memoria
+ * @param count Número de elementos (para un iterador, su tamaño)
+ * @param element_size Tamaño de cada elemento (sizeof(void *) para un iterador)
+ * @return Tamaño mínimo del buffer scratch de generic_stable_sort*
+ */
+size_t generic_stable_sort_scratch_size(size_t count, size_t element_size)
+{
+    return (count / 2 + 1) * element_size;
+}
+
+/**
+ * @brief Ordena de forma estable la vista de un GenericArrayIterator
+ * @param it Puntero al iterador a ordenar
+ * @param compare Función de comparación para determinar el orden
+ * @param scratch Buffer auxiliar opcional (NULL para reservarlo internamente)
+ * @param scratch_size Tamaño de scratch en bytes, al menos
+ *        generic_stable_sort_scratch_size(size, sizeof(void *))
+ * @return false si no se pudo reservar el buffer auxiliar (el iterador queda sin ordenar)
+ *
+ * Los elementos que compare da como iguales conservan su orden relativo, lo
+ * que permite ordenar por varias claves en pasadas sucesivas. Las entradas ya
+ * ordenadas o casi ordenadas se resuelven en tiempo casi lineal.
+ */
+bool generic_stable_sort(Iterator *it, CompareFunc compare, void *scratch, size_t scratch_size)
+{
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return true;
+
+    SortLayout layout = { .base = (char *)elements, .esize = sizeof(void *), .compare = compare, .indirect = true };
+    bool ok = stable_sort_layout(&layout, ((GenericArrayIterator *)it->impl)->size, scratch, scratch_size);
+
+    sort_finish(it);
+    return ok;
+}
+
+/**
+ * @brief Ordena de forma estable un array de registros en su buffer
+ * @param base Puntero al primer registro
+ * @param count Número de registros
+ * @param element_size Tamaño en bytes de cada registro
+ * @param compare Función de comparación, recibe punteros a los registros
+ * @param scratch Buffer auxiliar opcional (NULL para reservarlo internamente)
+ * @param scratch_size Tamaño de scratch en bytes, al menos
+ *        generic_stable_sort_scratch_size(count, element_size)
+ * @return false si no se pudo reservar el buffer auxiliar (el array queda sin ordenar)
+ */
+bool generic_stable_sort_records(void *base, size_t count, size_t element_size,
+                                 CompareFunc compare, void *scratch, size_t scratch_size)
+{
+    if (!base || count <= 1 || element_size == 0)
+        return true;
+
+    SortLayout layout = { .base = (char *)base, .esize = element_size, .compare = compare, .indirect = false };
+    return stable_sort_layout(&layout, count, scratch, scratch_size);
+}
+
+/*
+ * Selección adaptativa de estrategia. Antes de ordenar una tabla grande se
+ * toman SORT_SAMPLE_SIZE muestras: ventanas de elementos consecutivos
+ * repartidas por la entrada para medir cuánto está ya ordenada, y elementos
+ * sueltos para estimar cuántas claves distintas hay. Cuesta unas 500
+ * comparaciones, despreciable frente a las n log n de la ordenación.
+ */
+
+#define SORT_SAMPLE_SIZE 64  /**< Muestras de cada tipo (ventanas y elementos). */
+#define SORT_SAMPLE_WINDOW 4 /**< Elementos consecutivos por ventana de orden. */
+
+/**
+ * @brief Elige la estrategia para ordenar una tabla de n punteros.
+ */
+static SortStrategy sort_choose_strategy(void **elements, size_t n, CompareFunc compare)
+{
+    if (n < SORT_ADAPTIVE_MIN)
+        return SORT_STRATEGY_QUICKSORT;
+
+    size_t step = n / SORT_SAMPLE_SIZE;
+
+    // Ventanas de SORT_SAMPLE_WINDOW elementos consecutivos: en datos aleatorios
+    // pocas son monótonas; si casi todas lo son (en cualquier sentido) hay tramos largos
+    size_t monotone = 0;
+    for (size_t k = 0; k < SORT_SAMPLE_SIZE; k++)
+    {
+        size_t i = k * step;
+        bool ascending = true, descending = true;
+        for (size_t j = i; j + 1 < i + SORT_SAMPLE_WINDOW; j++)
+        {
+            int c = compare(elements[j], elements[j + 1]);
+            ascending = ascending && c <= 0;
+            descending = descending && c >= 0;
+        }
+        monotone += ascending || descending;
+    }
+    if (monotone + SORT_SAMPLE_SIZE / 16 >= SORT_SAMPLE_SIZE)
+        return SORT_STRATEGY_RUNS;
+
+    // Claves distintas de una muestra ordenada
+    void *sample[SORT_SAMPLE_SIZE];
+    for (size_t k = 0; k < SORT_SAMPLE_SIZE; k++)
+        sample[k] = elements[k * step + step / 2];
+    PointerSortContext ctx = { .elements = sample, .compare = compare };
+    pointer_sort(&ctx, 0, SORT_SAMPLE_SIZE);
+
+    size_t distinct = 1;
+    for (size_t k = 1; k < SORT_SAMPLE_SIZE; k++)
+        distinct += compare(sample[k - 1], sample[k]) != 0;
+    if (distinct <= SORT_SAMPLE_SIZE / 8)
+        return SORT_STRATEGY_THREE_WAY;
+
+    return SORT_STRATEGY_QUICKSORT;
+}
+
+/**
+ * @brief Ordena la vista de un GenericArrayIterator eligiendo la estrategia según la entrada
+ * @param it Puntero al iterador a ordenar
+ * @param compare Función de comparación para determinar el orden
+ * @return Estrategia usada (SORT_STRATEGY_NONE si no había nada que ordenar)
+ *
+ * A partir de SORT_ADAPTIVE_MIN elementos muestrea la entrada y usa:
+ *  - SORT_STRATEGY_RUNS si está casi ordenada o inversa (valores añadidos en
+ *    orden, lotes invertidos): detección de tramos, inversión de los
+ *    descendentes y fusión con galope, lineal si ya estaba ordenada.
+ *  - SORT_STRATEGY_THREE_WAY si hay pocas claves distintas (códigos de
+ *    estado, categorías): quicksort con partición a tres vías.
+ *  - SORT_STRATEGY_QUICKSORT en el resto de casos.
+ *
+ * El resultado es el mismo que el de generic_sort, que la usa internamente;
+ * el valor devuelto sirve para diagnóstico (ver sort_strategy_name).
+ */
+SortStrategy generic_sort_adaptive(Iterator *it, CompareFunc compare)
+{
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return SORT_STRATEGY_NONE;
+
+    size_t n = ((GenericArrayIterator *)it->impl)->size;
+    PointerSortContext ctx = { .elements = elements, .compare = compare };
+    SortStrategy strategy = sort_choose_strategy(elements, n, compare);
+
+    if (strategy == SORT_STRATEGY_RUNS)
+    {
+        SortLayout layout = { .base = (char *)elements, .esize = sizeof(void *), .compare = compare, .indirect = true };
+        // Sin memoria para las fusiones, pdqsort también es lineal en entradas ordenadas
+        if (!stable_sort_layout(&layout, n, NULL, 0))
+            strategy = SORT_STRATEGY_QUICKSORT;
+    }
+    if (strategy == SORT_STRATEGY_THREE_WAY)
+        pointer_three_way_sort(&ctx, 0, n, log2_int(n) + 1);
+    else if (strategy == SORT_STRATEGY_QUICKSORT)
+        pointer_sort(&ctx, 0, n);
+
+    sort_finish(it);
+    return strategy;
+}
+
+/**
+ * @brief Nombre legible de una estrategia de ordenación
+ * @param strategy Estrategia devuelta por generic_sort_adaptive
+ * @return Cadena estática ("none", "quicksort", "three-way" o "runs")
+ */
+const char *sort_strategy_name(SortStrategy strategy)
+{
+    switch (strategy)
+    {
+    case SORT_STRATEGY_QUICKSORT: return "quicksort";
+    case SORT_STRATEGY_THREE_WAY: return "three-way";
+    case SORT_STRATEGY_RUNS:      return "runs";
+    default:                      return "none";
+    }
+}
+
+/*
+ * Argsort: en lugar de mover los elementos se ordenan pares (puntero, índice)
+ * con los mismos motores que las demás ordenaciones y se devuelven los
+ * índices. Con apply_permutation la misma permutación reordena cualquier
+ * número de arrays paralelos.
+ */
+
+/**
+ * @brief Reserva y rellena las entradas de argsort con la vista de un GenericArrayIterator.
+ * @return Las entradas, o NULL si el iterador no es válido o no hay memoria.
+ */
+static ArgsortEntry *argsort_prepare(const Iterator *it, size_t *count)
+{
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops)
+        return NULL;
+
+    const GenericArrayIterator *iter = (const GenericArrayIterator *)it->impl;
+    ArgsortEntry *entries = malloc((iter->size ? iter->size : 1) * sizeof(ArgsortEntry));
+    if (!entries)
+        return NULL;
+
+    for (size_t i = 0; i < iter->size; i++)
+        entries[i] = (ArgsortEntry){ .element = generic_array_get(iter, i), .index = i };
+    *count = iter->size;
+    return entries;
+}
+
+static void argsort_finish(ArgsortEntry *entries, size_t count, size_t *perm)
+{
+    for (size_t i = 0; i < count; i++)
+        perm[i] = entries[i].index;
+    free(entries);
+}
+
+/**
+ * @brief Calcula la permutación que ordena la vista de un GenericArrayIterator
+ * @param it GenericArrayIterator cuyos elementos se ordenan (no se modifica)
+ * @param compare Función de comparación para determinar el orden
+ * @param perm Recibe size elementos: perm[i] es la posición en la vista del
+ *        elemento que va en el puesto i del orden
+ * @return false si el iterador no es un GenericArrayIterator o no hubo memoria
+ *
+ * Para un iterador recién creado sobre un array, las posiciones de la vista
+ * son los índices del array, así que perm se puede pasar directamente a
+ * apply_permutation para reordenar ese array y los paralelos a él.
+ */
+bool generic_argsort(const Iterator *it, CompareFunc compare, size_t *perm)
+{
+    size_t n = 0;
+    ArgsortEntry *entries = perm ? argsort_prepare(it, &n) : NULL;
+    if (!entries)
+        return false;
+
+    ArgsortContext ctx = { .entries = entries, .compare = compare };
+    argsort_sort(&ctx, 0, n);
+
+    argsort_finish(entries, n, perm);
+    return true;
+}
+
+/**
+ * @brief Igual que generic_argsort, pero los elementos iguales conservan su orden relativo
+ * @param it GenericArrayIterator cuyos elementos se ordenan (no se modifica)
+ * @param compare Función de comparación para determinar el orden
+ * @param perm Recibe size elementos (ver generic_argsort)
+ * @return false si el iterador no es un GenericArrayIterator o no hubo memoria
+ */
+bool generic_stable_argsort(const Iterator *it, CompareFunc compare, size_t *perm)
+{
+    size_t n = 0;
+    ArgsortEntry *entries = perm ? argsort_prepare(it, &n) : NULL;
+    if (!entries)
+        return false;
+
+    SortLayout layout = { .base = (char *)entries, .esize = sizeof(ArgsortEntry), .compare = compare, .indirect = true };
+    if (!stable_sort_layout(&layout, n, NULL, 0))
+    {
+        free(entries);
+        return false;
+    }
+
+    argsort_finish(entries, n, perm);
+    return true;
+}
+
+/**
+ * @brief Versión paralela de generic_argsort
+ * @param it GenericArrayIterator cuyos elementos se ordenan (no se modifica)
+ * @param compare Función de comparación para determinar el orden
+ * @param perm Recibe size elementos (ver generic_argsort)
+ * @param threads Número de hilos (0 = uno por procesador disponible)
+ * @return false si el iterador no es un GenericArrayIterator o no hubo memoria
+ *
+ * Por debajo del umbral de generic_parallel_sort_set_threshold usa el camino
+ * secuencial. La fusión es estable, pero no el orden dentro de cada bloque.
+ */
+bool generic_parallel_argsort(const Iterator *it, CompareFunc compare, size_t *perm, size_t threads)
+{
+    size_t n = 0;
+    ArgsortEntry *entries = perm ? argsort_prepare(it, &n) : NULL;
+    if (!entries)
+        return false;
+
+    SortLayout layout = { .base = (char *)entries, .esize = sizeof(ArgsortEntry), .compare = compare, .indirect = true };
+    if (!parallel_sort_layout(&layout, n, threads))
+    {
+        ArgsortContext ctx = { .entries = entries, .compare = compare };
+        argsort_sort(&ctx, 0, n);
+    }
+
+    argsort_finish(entries, n, perm);
+    return true;
+}
+
+#define PERMUTATION_BUFFER 256 /**< Elementos de hasta este tamaño se mueven con un buffer en la pila. */
+
+/**
+ * @brief Comprueba que perm contiene cada índice de [0, count) exactamente una vez.
+ *
+ * Cada índice visto se marca complementando la entrada de su posición, y
+ * todas las entradas se restauran antes de volver.
+ */
+static bool permutation_valid(size_t *perm, size_t count)
+{
+    bool valid = true;
+
+    for (size_t i = 0; i < count; i++)
+        if (perm[i] >= count)
+            return false;
+
+    for (size_t i = 0; i < count && valid; i++)
+    {
+        size_t k = perm[i] < count ? perm[i] : ~perm[i];
+        if (perm[k] >= count)
+            valid = false; // k ya apareció antes
+        else
+            perm[k] = ~perm[k];
+    }
+
+    for (size_t i = 0; i < count; i++)
+        if (perm[i] >= count)
+            perm[i] = ~perm[i];
+    return valid;
+}
+
+/**
+ * @brief Reordena un array en su sitio según una permutación
+ * @param base Puntero al primer elemento
+ * @param count Número de elementos
+ * @param element_size Tamaño en bytes de cada elemento
+ * @param perm Permutación de [0, count): el elemento perm[i] pasa a la posición i
+ *        (el formato de generic_argsort). Se usa para marcar los ciclos ya
+ *        recorridos y se restaura antes de volver.
+ * @return false si los argumentos no son válidos, perm no es una permutación
+ *         de [0, count) (el array no se toca) o no hubo memoria para un
+ *         elemento de más de PERMUTATION_BUFFER bytes
+ *
+ * Recorre cada ciclo de la permutación una vez, moviendo cada elemento
+ * exactamente una vez más un elemento por ciclo al buffer temporal; la memoria
+ * extra no depende de count. Aplicar la misma perm a varios arrays paralelos
+ * los deja ordenados por la columna de la que se obtuvo.
+ */
+bool apply_permutation(void *base, size_t count, size_t element_size, size_t *perm)
+{
+    if ((!base && count > 0) || element_size == 0 || (!perm && count > 0) || !permutation_valid(perm, count))
+        return false;
+
+    char stack_buffer[PERMUTATION_BUFFER];
+    char *tmp = element_size <= PERMUTATION_BUFFER ? stack_buffer : malloc(element_size);
+    if (!tmp)
+        return false;
+
+    char *a = (char *)base;
+    for (size_t i = 0; i < count; i++)
+    {
+        // Los ciclos ya recorridos están marcados con el índice complementado (>= count)
+        if (perm[i] >= count || perm[i] == i)
+            continue;
+
+        memcpy(tmp, a + i * element_size, element_size);
+        size_t j = i;
+        for (;;)
+        {
+            size_t k = perm[j];
+            perm[j] = ~k;
+            if (k == i)
+                break;
+            memcpy(a + j * element_size, a + k * element_size, element_size);
+            j = k;
+        }
+        memcpy(a + j * element_size, tmp, element_size);
+    }
+
+    for (size_t i = 0; i < count; i++)
+        if (perm[i] >= count)
+            perm[i] = ~perm[i];
+
+    if (tmp != stack_buffer)
+        free(tmp);
+    return true;
+}
+
+/*
+ * Ordenación de las filas de un MultiZipIterator de GenericArrayIterator:
+ * el motor trabaja sobre números de fila, la comparación recibe tuplas
+ * construidas al vuelo con las columnas clave y cada intercambio mueve la
+ * fila en todas las columnas, sin copiar los datos a un array de estructuras.
+ */
+
+#define ZIP_SORT_STACK_KEYS 16 /**< Columnas clave cuyas tuplas caben en la pila. */
+
 /**
- * @brief Intercambia dos elementos en el array del iterador
- * @param iter Puntero al iterador genérico
- * @param i Índice del primer elemento
- * @param j Índice del segundo elemento
+ * @struct ZipSortContext
+ * @brief Contexto del motor de ordenación sobre las filas de un MultiZipIterator.
  */
-static void swap_elements(GenericArrayIterator *iter, size_t i, size_t j)
+typedef struct ZipSortContext {
+    const MultiZipIterator *zip; /**< Columnas (todas GenericArrayIterator). */
+    const size_t *keys;          /**< Columnas que forman las tuplas que se comparan. */
+    size_t key_count;            /**< Número de columnas clave. */
+    void **left;                 /**< Tupla de la primera fila comparada. */
+    void **right;                /**< Tupla de la segunda fila comparada. */
+    CompareFunc compare;         /**< Comparación entre dos tuplas void*[key_count]. */
+} ZipSortContext;
+
+static inline const GenericArrayIterator *zip_column(const ZipSortContext *ctx, size_t c)
+{
+    return (const GenericArrayIterator *)ctx->zip->iterators[c].impl;
+}
+
+static inline bool zip_less(const ZipSortContext *ctx, size_t i, size_t j)
+{
+    for (size_t k = 0; k < ctx->key_count; k++)
+    {
+        const GenericArrayIterator *column = zip_column(ctx, ctx->keys ? ctx->keys[k] : k);
+        ctx->left[k] = generic_array_get(column, i);
+        ctx->right[k] = generic_array_get(column, j);
+    }
+    return ctx->compare(ctx->left, ctx->right) < 0;
+}
+
+static inline void zip_swap(const ZipSortContext *ctx, size_t i, size_t j)
 {
-    void *temp = iter->elements[i];
-    iter->elements[i] = iter->elements[j];
-    iter->elements[j] = temp;
+    for (size_t c = 0; c < ctx->zip->count; c++)
+    {
+        const GenericArrayIterator *column = zip_column(ctx, c);
+        swap_record_bytes(generic_array_get(column, i), generic_array_get(column, j), column->element_size);
+    }
 }
 
+#define SORT_NAME(name) zip_##name
+#define SORT_CTX ZipSortContext
+#define SORT_LESS(ctx, i, j) zip_less((ctx), (i), (j))
+#define SORT_SWAP(ctx, i, j) zip_swap((ctx), (i), (j))
+#include "CSorttingTemplate.h"
+
 /**
- * @brief Ordenación por inserción para pequeños segmentos
- * @param it Puntero al iterador
- * @param compare Función de comparación
+ * @brief Ordena las filas de un MultiZipIterator moviéndolas en todas sus columnas
+ * @param it MultiZipIterator cuyas columnas son todas GenericArrayIterator
+ * @param keys Columnas por las que se ordena, en el orden en que aparecen en
+ *        las tuplas que recibe compare (NULL = todas las columnas)
+ * @param key_count Número de columnas en keys (ignorado si keys es NULL)
+ * @param compare Función de comparación; recibe dos tuplas void*[key_count]
+ *        con punteros a los elementos de las columnas clave de cada fila
+ * @return false si el iterador no es un MultiZipIterator de GenericArrayIterator,
+ *         alguna columna clave no existe o no hubo memoria para las tuplas
  *
- * Esta función es eficiente para arrays pequeños (<16 elementos) y se usa
- * como optimización en Introsort para estos casos.
+ * Se ordenan las filas [0, n), con n el tamaño de la columna más corta. Igual
+ * que generic_sort_inplace, los elementos se intercambian dentro de los
+ * buffers del usuario (en el orden de la vista de cada columna), así que la
+ * única memoria extra son las dos tuplas de comparación, en la pila para
+ * hasta ZIP_SORT_STACK_KEYS columnas clave. Conviene llamarla antes de
+ * empezar a recorrer el iterador.
  */
-static void insertion_sort(Iterator *it, CompareFunc compare)
+bool generic_sort_zip(Iterator *it, const size_t *keys, size_t key_count, CompareFunc compare)
 {
-    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    if (!it || !it->impl || it->category != ZIP_ITERATOR || !compare)
+        return false;
+
+    const MultiZipIterator *zip = (const MultiZipIterator *)it->impl;
+    size_t rows = SIZE_MAX;
+    for (size_t c = 0; c < zip->count; c++)
+    {
+        const Iterator *column = &zip->iterators[c];
+        if (!column->impl || column->ops != &generic_array_iterator_ops)
+            return false;
+        size_t size = ((const GenericArrayIterator *)column->impl)->size;
+        rows = size < rows ? size : rows;
+    }
+
+    if (!keys)
+        key_count = zip->count;
+    for (size_t k = 0; keys && k < key_count; k++)
+        if (keys[k] >= zip->count)
+            return false;
+    if (zip->count == 0 || rows <= 1)
+        return true;
+
+    void *stack_tuples[2 * ZIP_SORT_STACK_KEYS];
+    void **tuples = key_count <= ZIP_SORT_STACK_KEYS ? stack_tuples : malloc(2 * key_count * sizeof(void *));
+    if (!tuples)
+        return false;
+
+    ZipSortContext ctx = {
+        .zip = zip,
+        .keys = keys,
+        .key_count = key_count,
+        .left = tuples,
+        .right = tuples + key_count,
+        .compare = compare
+    };
+    zip_sort(&ctx, 0, rows);
+
+    if (tuples != stack_tuples)
+        free(tuples);
+    return true;
+}
+
+/*
+ * Ordenaciones especializadas por tipo primitivo (generic_sort_<tipo> y
+ * generic_sort_<tipo>_array). La comparación se escribe en línea en lugar de
+ * pasar por un CompareFunc, lo que permite al compilador integrarla en el
+ * motor. Los flotantes usan un orden total que envía los NaN al final.
+ */
+#define FLOAT_LESS(a, b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+#define VALUE_LESS(a, b) ((a) < (b))
+
+/*
+ * Redes de ordenación SIMD para las hojas de las variantes sobre arrays de
+ * tipos numéricos. Sin AVX2 en tiempo de ejecución (o fuera de x86 con GCC o
+ * Clang) las hojas siguen con insertion sort.
+ */
+#define NETWORK_SUFFIX int32
+#define NETWORK_T int32_t
+#define NETWORK_SHIFT 0
+#define NETWORK_MIN _mm256_min_epi32
+#define NETWORK_MAX _mm256_max_epi32
+#define NETWORK_SENTINEL INT32_MAX
+#include "CSorttingNetworks.h"
 
-    for (size_t i = 1; i < iter->size; i++)
+#define NETWORK_SUFFIX uint32
+#define NETWORK_T uint32_t
+#define NETWORK_SHIFT 0
+#define NETWORK_MIN _mm256_min_epu32
+#define NETWORK_MAX _mm256_max_epu32
+#define NETWORK_SENTINEL UINT32_MAX
+#include "CSorttingNetworks.h"
+
+#define NETWORK_SUFFIX int64
+#define NETWORK_T int64_t
+#define NETWORK_SHIFT 1
+#define NETWORK_MIN network_min_epi64
+#define NETWORK_MAX network_max_epi64
+#define NETWORK_SENTINEL INT64_MAX
+#include "CSorttingNetworks.h"
+
+#define NETWORK_SUFFIX float
+#define NETWORK_T float
+#define NETWORK_SHIFT 0
+#define NETWORK_MIN network_min_ps
+#define NETWORK_MAX network_max_ps
+#define NETWORK_SENTINEL INFINITY
+#define NETWORK_IS_NAN(x) ((x) != (x))
+#include "CSorttingNetworks.h"
+
+#define NETWORK_SUFFIX double
+#define NETWORK_T double
+#define NETWORK_SHIFT 1
+#define NETWORK_MIN network_min_pd
+#define NETWORK_MAX network_max_pd
+#define NETWORK_SENTINEL INFINITY
+#define NETWORK_IS_NAN(x) ((x) != (x))
+#include "CSorttingNetworks.h"
+
+#define TYPED_SUFFIX int32
+#define TYPED_T int32_t
+#define TYPED_LESS VALUE_LESS
+#ifdef SORT_NETWORKS_AVAILABLE
+#define TYPED_SMALL_SORT network_sort_int32
+#define TYPED_SMALL_SORT_MAX NETWORK_MAX_ELEMENTS(int32_t)
+#endif
+#include "CSorttingTyped.h"
+
+#define TYPED_SUFFIX int64
+#define TYPED_T int64_t
+#define TYPED_LESS VALUE_LESS
+#ifdef SORT_NETWORKS_AVAILABLE
+#define TYPED_SMALL_SORT network_sort_int64
+#define TYPED_SMALL_SORT_MAX NETWORK_MAX_ELEMENTS(int64_t)
+#endif
+#include "CSorttingTyped.h"
+
+#define TYPED_SUFFIX uint32
+#define TYPED_T uint32_t
+#define TYPED_LESS VALUE_LESS
+#ifdef SORT_NETWORKS_AVAILABLE
+#define TYPED_SMALL_SORT network_sort_uint32
+#define TYPED_SMALL_SORT_MAX NETWORK_MAX_ELEMENTS(uint32_t)
+#endif
+#include "CSorttingTyped.h"
+
+#define TYPED_SUFFIX uint64
+#define TYPED_T uint64_t
+#define TYPED_LESS VALUE_LESS
+#include "CSorttingTyped.h"
+
+#define TYPED_SUFFIX float
+#define TYPED_T float
+#define TYPED_LESS FLOAT_LESS
+#ifdef SORT_NETWORKS_AVAILABLE
+#define TYPED_SMALL_SORT network_sort_float
+#define TYPED_SMALL_SORT_MAX NETWORK_MAX_ELEMENTS(float)
+#endif
+#include "CSorttingTyped.h"
+
+#define TYPED_SUFFIX double
+#define TYPED_T double
+#define TYPED_LESS FLOAT_LESS
+#ifdef SORT_NETWORKS_AVAILABLE
+#define TYPED_SMALL_SORT network_sort_double
+#define TYPED_SMALL_SORT_MAX NETWORK_MAX_ELEMENTS(double)
+#endif
+#include "CSorttingTyped.h"
+
+/*
+ * Cadenas: multikey quicksort (Bentley y Sedgewick) con los caracteres en
+ * caché. Cada partición es a tres vías sobre los 8 caracteres a partir de la
+ * posición `depth`, empaquetados en big-endian en un entero de 64 bits, así
+ * que el prefijo común de un grupo nunca se vuelve a comparar. Al llegar a una
+ * nueva profundidad se copian a un array auxiliar y las particiones solo leen
+ * ese array: cada cadena se visita una vez por cada 8 caracteres en lugar de
+ * una vez por comparación.
+ */
+
+#define STRING_SORT_INSERTION 16 /**< Grupos menores que esto se ordenan por inserción. */
+#define STRING_SORT_NINTHER 256  /**< A partir de este tamaño el pivote es la mediana de 9. */
+
+/**
+ * @struct StringSortContext
+ * @brief Cadenas a ordenar, su carácter en caché y la tabla que se permuta con ellas.
+ */
+typedef struct StringSortContext {
+    const char **strings; /**< Cadenas; es el array del usuario o una copia de lo apuntado por items. */
+    void **items;         /**< Tabla de punteros de un GenericArrayIterator, o NULL. */
+    uint64_t *cache;      /**< 8 caracteres de cada cadena en la profundidad actual de su grupo. */
+} StringSortContext;
+
+static inline void string_swap(const StringSortContext *ctx, size_t i, size_t j)
+{
+    const char *s = ctx->strings[i];
+    ctx->strings[i] = ctx->strings[j];
+    ctx->strings[j] = s;
+
+    uint64_t c = ctx->cache[i];
+    ctx->cache[i] = ctx->cache[j];
+    ctx->cache[j] = c;
+
+    if (ctx->items)
     {
+        void *item = ctx->items[i];
+        ctx->items[i] = ctx->items[j];
+        ctx->items[j] = item;
+    }
+}
+
+/**
+ * @brief Ordena por inserción un grupo cuyas cadenas comparten los `depth` primeros caracteres.
+ */
+static void string_insertion_sort(const StringSortContext *ctx, size_t begin, size_t end, size_t depth)
+{
+    for (size_t i = begin + 1; i < end; i++)
+    {
+        const char *s = ctx->strings[i];
+        void *item = ctx->items ? ctx->items[i] : NULL;
         size_t j = i;
-        while (j > 0 && compare(iter->elements[j - 1], iter->elements[j]) > 0)
+        while (j > begin && strcmp(ctx->strings[j - 1] + depth, s + depth) > 0)
         {
-            swap_elements(iter, j, j - 1);
+            ctx->strings[j] = ctx->strings[j - 1];
+            if (ctx->items)
+                ctx->items[j] = ctx->items[j - 1];
             j--;
         }
+        ctx->strings[j] = s;
+        if (ctx->items)
+            ctx->items[j] = item;
     }
 }
 
 /**
- * @brief Función auxiliar para HeapSort que mantiene la propiedad de heap
- * @param it Puntero al iterador
- * @param n Tamaño del heap
- * @param i Índice del elemento a heapify
- * @param compare Función de comparación
+ * @brief Hasta 8 caracteres de s en big-endian, rellenando con ceros tras el terminador.
  */
-static void heapify(Iterator *it, size_t n, size_t i, CompareFunc compare)
+static inline uint64_t string_load8(const char *s)
 {
-    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    const unsigned char *u = (const unsigned char *)s;
+    uint64_t key = 0;
+    size_t i = 0;
 
-    size_t largest = i;
-    size_t left = 2 * i + 1;
-    size_t right = 2 * i + 2;
+    for (; i < 8 && u[i]; i++)
+        key = (key << 8) | u[i];
+    // Desplazar 64 bits de golpe (cadena vacía) no está definido
+    return i == 0 ? 0 : i < 8 ? key << (8 * (8 - i)) : key;
+}
 
-    if (left < n && compare(iter->elements[left], iter->elements[largest]) > 0)
-        largest = left;
+static inline size_t string_median3(const uint64_t *c, size_t a, size_t b, size_t d)
+{
+    if (c[a] < c[b])
+        return c[b] < c[d] ? b : (c[a] < c[d] ? d : a);
+    return c[a] < c[d] ? a : (c[b] < c[d] ? d : b);
+}
 
-    if (right < n && compare(iter->elements[right], iter->elements[largest]) > 0)
-        largest = right;
+/**
+ * @brief Multikey quicksort de [begin, end), cuyas cadenas comparten los `depth` primeros caracteres.
+ *
+ * Tras cada partición se recorren con recursión las dos partes más pequeñas
+ * (cada una tiene como mucho la mitad de los elementos, así que la pila queda
+ * en O(log n)) y se continúa en el bucle con la mayor. Los grupos menor y
+ * mayor siguen en la misma profundidad y conservan su caché; el igual avanza
+ * 8 caracteres y la vuelve a llenar.
+ */
+static void string_mkqs(const StringSortContext *ctx, size_t begin, size_t end, size_t depth, bool cached)
+{
+    uint64_t *cache = ctx->cache;
 
-    if (largest != i)
+    while (end - begin >= STRING_SORT_INSERTION)
     {
-        swap_elements(iter, i, largest);
-        heapify(it, n, largest, compare);
+        if (!cached)
+            for (size_t i = begin; i < end; i++)
+                cache[i] = string_load8(ctx->strings[i] + depth);
+
+        size_t n = end - begin;
+        size_t pivot;
+        if (n >= STRING_SORT_NINTHER)
+        {
+            size_t s = n / 8;
+            pivot = string_median3(cache,
+                                   string_median3(cache, begin, begin + s, begin + 2 * s),
+                                   string_median3(cache, begin + n / 2 - s, begin + n / 2, begin + n / 2 + s),
+                                   string_median3(cache, end - 1 - 2 * s, end - 1 - s, end - 1));
+        }
+        else
+            pivot = string_median3(cache, begin, begin + n / 2, end - 1);
+        uint64_t p = cache[pivot];
+        // Si los 8 caracteres incluyen el terminador, las cadenas iguales al pivote son idénticas
+        bool ended = (p & 0xFF) == 0;
+
+        // Partición a tres vías: [begin, lt) < p, [lt, gt) == p, [gt, end) > p
+        size_t lt = begin, i = begin, gt = end;
+        while (i < gt)
+        {
+            if (cache[i] < p)
+                string_swap(ctx, lt++, i++);
+            else if (cache[i] > p)
+                string_swap(ctx, i, --gt);
+            else
+                i++;
+        }
+
+        size_t less = lt - begin, equal = gt - lt, greater = end - gt;
+        size_t eq_size = ended ? 0 : equal;
+
+        if (less >= equal && less >= greater)
+        {
+            if (eq_size > 1)
+                string_mkqs(ctx, lt, gt, depth + 8, false);
+            if (greater > 1)
+                string_mkqs(ctx, gt, end, depth, true);
+            end = lt;
+            cached = true;
+        }
+        else if (greater >= equal)
+        {
+            if (less > 1)
+                string_mkqs(ctx, begin, lt, depth, true);
+            if (eq_size > 1)
+                string_mkqs(ctx, lt, gt, depth + 8, false);
+            begin = gt;
+            cached = true;
+        }
+        else
+        {
+            if (less > 1)
+                string_mkqs(ctx, begin, lt, depth, true);
+            if (greater > 1)
+                string_mkqs(ctx, gt, end, depth, true);
+            if (ended)
+                return;
+            begin = lt;
+            end = gt;
+            depth += 8;
+            cached = false;
+        }
     }
+
+    string_insertion_sort(ctx, begin, end, depth);
+}
+
+/**
+ * @brief Comparación de punteros a cadena para el camino sin memoria auxiliar.
+ */
+static int string_compare(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
 }
 
 /**
- * @brief Implementación de HeapSort
- * @param it Puntero al iterador
- * @param compare Función de comparación
+ * @brief Ordena la vista de un GenericArrayIterator de cadenas (create_string_array_iterator)
+ * @param it Puntero al iterador a ordenar; cada elemento es un `const char *`
  *
- * Se usa cuando la recursión en QuickSort es demasiado profunda para garantizar
- * O(n log n) en el peor caso.
+ * Mismo orden que strcmp, con multikey quicksort: las cadenas con prefijos
+ * comunes largos (URLs, rutas, claves de log) no repiten la comparación del
+ * prefijo. Igual que generic_sort, permuta la tabla de punteros. Necesita
+ * 16 bytes auxiliares por elemento; si no hay memoria ordena con pdqsort.
  */
-static void heap_sort(Iterator *it, CompareFunc compare)
+void generic_sort_str(Iterator *it)
 {
-    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
-    size_t n = iter->size;
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return;
+
+    size_t n = ((GenericArrayIterator *)it->impl)->size;
+    const char **strings = malloc(n * sizeof(const char *));
+    uint64_t *cache = malloc(n * sizeof(uint64_t));
+    if (strings && cache)
+    {
+        for (size_t i = 0; i < n; i++)
+            strings[i] = *(const char *const *)elements[i];
+        StringSortContext ctx = { .strings = strings, .items = elements, .cache = cache };
+        string_mkqs(&ctx, 0, n, 0, false);
+    }
+    else
+    {
+        PointerSortContext ctx = { .elements = elements, .compare = string_compare };
+        pointer_sort(&ctx, 0, n);
+    }
+    free(strings);
+    free(cache);
+
+    sort_finish(it);
+}
+
+/**
+ * @brief Ordena un array de cadenas en su sitio
+ * @param array Array de punteros a cadenas terminadas en '\0'
+ * @param count Número de cadenas
+ *
+ * Igual que generic_sort_str, con 8 bytes auxiliares por elemento.
+ */
+void generic_sort_str_array(const char **array, size_t count)
+{
+    if (!array || count <= 1)
+        return;
+
+    uint64_t *cache = malloc(count * sizeof(uint64_t));
+    if (!cache)
+    {
+        generic_sort_records(array, count, sizeof(const char *), string_compare);
+        return;
+    }
+
+    StringSortContext ctx = { .strings = array, .items = NULL, .cache = cache };
+    string_mkqs(&ctx, 0, count, 0, false);
+    free(cache);
+}
+
+/*
+ * Radix sort. Las claves se normalizan a enteros sin signo de 64 bits cuyo
+ * orden natural es el orden deseado, y se ordenan pares (clave, carga) donde
+ * la carga es el puntero de la tabla o el índice del registro. Así cada pasada
+ * mueve 16 bytes por elemento sea cual sea el tamaño del registro.
+ */
+
+#define RADIX_MSD_THRESHOLD 65536 /**< Por debajo de este tamaño se usa MSD (American flag sort). */
+#define RADIX_MSD_INSERTION 32    /**< Cubetas MSD menores que esto se ordenan por inserción. */
 
-    // Construir el heap
-    for (int i = n / 2 - 1; i >= 0; i--)
-        heapify(it, n, i, compare);
+/**
+ * @struct RadixPair
+ * @brief Clave normalizada y carga (puntero o índice) de un elemento.
+ */
+typedef struct RadixPair {
+    uint64_t key;     /**< Clave normalizada. */
+    uintptr_t value;  /**< Puntero al elemento o índice del registro. */
+} RadixPair;
+
+/**
+ * @brief Convierte los bits de una clave en un entero sin signo con el mismo orden.
+ * @param raw Bits de la clave (los `width` bytes bajos).
+ * @param key Descripción de la clave.
+ * @return Clave normalizada.
+ */
+static inline uint64_t radix_normalize(uint64_t raw, const RadixKey *key)
+{
+    unsigned bits = (unsigned)key->width * 8;
+    uint64_t mask = bits == 64 ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1);
+    uint64_t sign = (uint64_t)1 << (bits - 1);
 
-    // Extraer elementos del heap
-    for (int i = n - 1; i > 0; i--)
+    raw &= mask;
+    switch (key->type)
     {
-        swap_elements(iter, 0, i);
-        heapify(it, i, 0, compare);
+    case RADIX_KEY_SIGNED:
+        return raw ^ sign;
+    case RADIX_KEY_FLOAT:
+        // Negativos: invertir todos los bits; positivos: activar el bit de signo
+        return (raw & sign) ? (~raw & mask) : (raw | sign);
+    default:
+        return raw;
     }
 }
 
 /**
- * @brief Función de partición para QuickSort
- * @param it Puntero al iterador
- * @param low Índice inferior
- * @param high Índice superior
- * @param compare Función de comparación
- * @return Índice del pivote después de la partición
+ * @brief Lee los bits de la clave de un elemento.
  */
-static size_t partition(Iterator *it, size_t low, size_t high, CompareFunc compare)
+static inline uint64_t radix_extract(const void *element, const RadixKey *key)
 {
-    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
+    if (key->key_fn)
+        return key->key_fn(element);
+
+    const char *p = (const char *)element + key->offset;
+    switch (key->width)
+    {
+    case 1: { uint8_t v;  memcpy(&v, p, 1); return v; }
+    case 2: { uint16_t v; memcpy(&v, p, 2); return v; }
+    case 4: { uint32_t v; memcpy(&v, p, 4); return v; }
+    default: { uint64_t v; memcpy(&v, p, 8); return v; }
+    }
+}
+
+/**
+ * @brief Radix sort LSD (estable) de pares con dígitos de 8 bits.
+ *
+ * Calcula los histogramas de todos los dígitos en una sola pasada y omite
+ * los dígitos en los que todas las claves coinciden.
+ *
+ * @param pairs Pares a ordenar; al terminar contienen el resultado.
+ * @param scratch Buffer auxiliar de n pares.
+ * @return false si no hubo memoria para los histogramas (los pares quedan sin ordenar).
+ */
+static bool radix_lsd(RadixPair *pairs, RadixPair *scratch, size_t n, size_t width)
+{
+    size_t (*counts)[256] = calloc(width, sizeof(*counts));
+    if (!counts)
+        return false;
 
-    void *pivot = iter->elements[high];
-    size_t i = low;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t k = pairs[i].key;
+        for (size_t d = 0; d < width; d++)
+            counts[d][(k >> (8 * d)) & 0xFF]++;
+    }
 
-    for (size_t j = low; j < high; j++)
+    RadixPair *src = pairs;
+    RadixPair *dst = scratch;
+    for (size_t d = 0; d < width; d++)
     {
-        if (compare(iter->elements[j], pivot) <= 0)
+        size_t *count = counts[d];
+        unsigned shift = (unsigned)(8 * d);
+
+        // Dígito constante en todas las claves: la pasada no cambiaría nada
+        if (count[(src[0].key >> shift) & 0xFF] == n)
+            continue;
+
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; b++)
         {
-            swap_elements(iter, i, j);
-            i++;
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
         }
+
+        for (size_t i = 0; i < n; i++)
+            dst[count[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+        RadixPair *tmp = src;
+        src = dst;
+        dst = tmp;
     }
-    swap_elements(iter, i, high);
-    return i;
+
+    if (src != pairs)
+        memcpy(pairs, src, n * sizeof(RadixPair));
+    free(counts);
+    return true;
 }
 
 /**
- * @brief Implementación principal de Introsort
- * @param it Puntero al iterador
- * @param begin Índice inicial
- * @param end Índice final
- * @param depth_limit Límite de profundidad de recursión
- * @param compare Función de comparación
- *
- * Esta función implementa el algoritmo Introsort que comienza con QuickSort,
- * cambia a HeapSort si la recursión es demasiado profunda, y usa InsertionSort
- * para subarrays pequeños.
+ * @brief Radix sort MSD in situ (American flag sort) desde el dígito `digit` hacia abajo.
  */
-static void introsort_impl(Iterator *it, size_t begin, size_t end,
-                           int depth_limit, CompareFunc compare)
+static void radix_msd(RadixPair *pairs, size_t n, int digit)
 {
-    //GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
-    size_t size = end - begin + 1;
+    if (n < RADIX_MSD_INSERTION)
+    {
+        for (size_t i = 1; i < n; i++)
+        {
+            RadixPair tmp = pairs[i];
+            size_t j = i;
+            while (j > 0 && tmp.key < pairs[j - 1].key)
+            {
+                pairs[j] = pairs[j - 1];
+                j--;
+            }
+            pairs[j] = tmp;
+        }
+        return;
+    }
+
+    unsigned shift = (unsigned)(8 * digit);
+    size_t count[256] = {0};
+    for (size_t i = 0; i < n; i++)
+        count[(pairs[i].key >> shift) & 0xFF]++;
 
-    // Usar insertion sort para arrays pequeños
-    if (size < 16)
+    // Todas las claves comparten este dígito: pasar directamente al siguiente
+    if (count[(pairs[0].key >> shift) & 0xFF] == n)
     {
-        insertion_sort(it, compare);
+        if (digit > 0)
+            radix_msd(pairs, n, digit - 1);
         return;
     }
 
-    // Si la profundidad es cero, usar heap sort
-    if (depth_limit == 0)
+    size_t head[256], tail[256];
+    size_t offset = 0;
+    for (size_t b = 0; b < 256; b++)
     {
-        heap_sort(it, compare);
+        head[b] = offset;
+        offset += count[b];
+        tail[b] = offset;
+    }
+
+    // Permutación en ciclos: cada elemento va directamente a su cubeta
+    for (size_t b = 0; b < 256; b++)
+    {
+        while (head[b] < tail[b])
+        {
+            RadixPair v = pairs[head[b]];
+            size_t d = (v.key >> shift) & 0xFF;
+            while (d != b)
+            {
+                RadixPair tmp = pairs[head[d]];
+                pairs[head[d]++] = v;
+                v = tmp;
+                d = (v.key >> shift) & 0xFF;
+            }
+            pairs[head[b]++] = v;
+        }
+    }
+
+    if (digit == 0)
         return;
+
+    size_t start = 0;
+    for (size_t b = 0; b < 256; b++)
+    {
+        if (count[b] > 1)
+            radix_msd(pairs + start, count[b], digit - 1);
+        start += count[b];
+    }
+}
+
+/**
+ * @brief Ordena los pares eligiendo LSD o MSD según el número de elementos.
+ * @return false si no hubo memoria para el buffer auxiliar o los histogramas de LSD.
+ */
+static bool radix_sort_pairs(RadixPair *pairs, size_t n, size_t width)
+{
+    if (n < RADIX_MSD_THRESHOLD)
+    {
+        radix_msd(pairs, n, (int)width - 1);
+        return true;
     }
 
-    // Caso normal: Quick Sort
-    size_t pivot = partition(it, begin, end, compare);
-    if (pivot > begin + 1)
-        introsort_impl(it, begin, pivot - 1, depth_limit - 1, compare);
-    if (pivot + 1 < end)
-        introsort_impl(it, pivot + 1, end, depth_limit - 1, compare);
+    RadixPair *scratch = malloc(n * sizeof(RadixPair));
+    if (!scratch)
+        return false;
+    bool ok = radix_lsd(pairs, scratch, n, width);
+    free(scratch);
+    return ok;
 }
 
-#include <stddef.h> // para size_t
+/**
+ * @brief Comprueba que una RadixKey describe una clave utilizable
+ * @param key Descripción de la clave
+ * @return true si width es 1, 2, 4 u 8 (4 u 8 para flotantes)
+ */
+bool radix_key_valid(const RadixKey *key)
+{
+    return key && (key->width == 1 || key->width == 2 || key->width == 4 || key->width == 8) &&
+           (key->type != RADIX_KEY_FLOAT || key->width == 4 || key->width == 8);
+}
 
-static inline int log2_int(size_t n) {
-    if (n == 0) return -1; // indefinido para log2(0)
+/**
+ * @brief Clave normalizada de un elemento
+ * @param element Puntero al elemento
+ * @param key Descripción de la clave (válida según radix_key_valid)
+ * @return Entero sin signo cuyo orden natural es el orden de la clave
+ */
+uint64_t radix_key_value(const void *element, const RadixKey *key)
+{
+    return radix_normalize(radix_extract(element, key), key);
+}
 
-#if defined(__GNUC__) || defined(__clang__)
-#if SIZE_MAX == UINT64_MAX
-    return 63 - __builtin_clzll(n);
-#else
-    return 31 - __builtin_clz((unsigned int)n);
-#endif
+/**
+ * @brief Normaliza los bits de una clave ya extraída
+ * @param raw Bits de la clave, como los devolvería RadixKey::key_fn
+ * @param key Descripción de la clave (válida según radix_key_valid)
+ * @return Entero sin signo cuyo orden natural es el orden de la clave
+ */
+uint64_t radix_key_normalize(uint64_t raw, const RadixKey *key)
+{
+    return radix_normalize(raw, key);
+}
 
-#elif defined(_MSC_VER)
-#include <intrin.h>
-    unsigned long index;
-#if defined(_M_X64) || defined(_M_ARM64)
-    _BitScanReverse64(&index, n);
-#else
-    _BitScanReverse(&index, (unsigned long)n);
-#endif
-    return (int)index;
+/**
+ * @brief Ordena la vista de un GenericArrayIterator con radix sort
+ * @param it Puntero al iterador a ordenar
+ * @param key Descripción de la clave de cada elemento
+ * @return true si se ordenó, false si la clave no es válida o no hubo memoria
+ *
+ * Igual que generic_sort, permuta la tabla de punteros y no el buffer original.
+ * Usa LSD (estable) a partir de RADIX_MSD_THRESHOLD elementos y MSD en situ por
+ * debajo, donde las cubetas pequeñas terminan antes de recorrer toda la clave.
+ */
+bool generic_radix_sort(Iterator *it, const RadixKey *key)
+{
+    if (!radix_key_valid(key))
+        return false;
 
-#else
-    // Fallback portable version
-    int res = 0;
-    while (n >>= 1) res++;
-    return res;
-#endif
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops)
+        return false;
+    if (((GenericArrayIterator *)it->impl)->size <= 1)
+        return true;
+
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return false;
+
+    size_t n = ((GenericArrayIterator *)it->impl)->size;
+    RadixPair *pairs = malloc(n * sizeof(RadixPair));
+    if (!pairs)
+        return false;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        pairs[i].key = radix_normalize(radix_extract(elements[i], key), key);
+        pairs[i].value = (uintptr_t)elements[i];
+    }
+
+    bool ok = radix_sort_pairs(pairs, n, key->width);
+    if (ok)
+    {
+        for (size_t i = 0; i < n; i++)
+            elements[i] = (void *)pairs[i].value;
+        sort_finish(it);
+    }
+
+    free(pairs);
+    return ok;
+}
+
+/**
+ * @brief Ordena un array de registros en su buffer con radix sort
+ * @param base Puntero al primer registro
+ * @param count Número de registros
+ * @param element_size Tamaño en bytes de cada registro
+ * @param key Descripción de la clave de cada registro
+ * @return true si se ordenó, false si la clave no es válida o no hubo memoria
+ *
+ * Ordena pares (clave, índice) y después coloca los registros en su sitio a
+ * través de un buffer auxiliar de count * element_size bytes.
+ */
+bool generic_radix_sort_records(void *base, size_t count, size_t element_size, const RadixKey *key)
+{
+    if (!radix_key_valid(key) || !base || element_size == 0)
+        return false;
+    if (count <= 1)
+        return true;
+
+    RadixPair *pairs = malloc(count * sizeof(RadixPair));
+    char *records = malloc(count * element_size);
+    if (!pairs || !records)
+    {
+        free(pairs);
+        free(records);
+        return false;
+    }
+
+    char *data = (char *)base;
+    for (size_t i = 0; i < count; i++)
+    {
+        pairs[i].key = radix_normalize(radix_extract(data + i * element_size, key), key);
+        pairs[i].value = i;
+    }
+
+    bool ok = radix_sort_pairs(pairs, count, key->width);
+    if (ok)
+    {
+        for (size_t i = 0; i < count; i++)
+            memcpy(records + i * element_size, data + pairs[i].value * element_size, element_size);
+        memcpy(data, records, count * element_size);
+    }
+
+    free(records);
+    free(pairs);
+    return ok;
 }
 
+/*
+ * Ordenación con clave en caché: cada elemento se resume una sola vez en una
+ * clave normalizada de 64 bits (p. ej. los 8 primeros bytes de una cadena)
+ * y se ordenan pares (clave, puntero) de 16 bytes. La comparación completa
+ * solo se llama cuando dos claves empatan, y la mayoría de comparaciones
+ * leen el array compacto de pares en lugar de los elementos.
+ */
+
+/**
+ * @struct CachedSortContext
+ * @brief Contexto del motor de ordenación sobre pares (clave en caché, puntero).
+ */
+typedef struct CachedSortContext {
+    RadixPair *pairs;    /**< Pares a ordenar; value es el puntero al elemento. */
+    CompareFunc compare; /**< Desempate entre claves iguales, o NULL. */
+} CachedSortContext;
+
+static inline bool cached_pair_less(const CachedSortContext *ctx, const RadixPair *a, const RadixPair *b)
+{
+    if (a->key != b->key)
+        return a->key < b->key;
+    return ctx->compare && ctx->compare((const void *)a->value, (const void *)b->value) < 0;
+}
 
+#define SORT_NAME(name) cached_##name
+#define SORT_CTX CachedSortContext
+#define SORT_LESS(ctx, i, j) cached_pair_less((ctx), &(ctx)->pairs[i], &(ctx)->pairs[j])
+#define SORT_SWAP(ctx, i, j)                 \
+    do {                                     \
+        RadixPair tmp_ = (ctx)->pairs[i];    \
+        (ctx)->pairs[i] = (ctx)->pairs[j];   \
+        (ctx)->pairs[j] = tmp_;              \
+    } while (0)
+#define SORT_VALUE_T RadixPair
+#define SORT_GET(ctx, i) ((ctx)->pairs[i])
+#define SORT_SET(ctx, i, v) ((ctx)->pairs[i] = (v))
+#define SORT_VALUE_LESS(ctx, v, i) cached_pair_less((ctx), &(v), &(ctx)->pairs[i])
+#include "CSorttingTemplate.h"
 
 /**
- * @brief Función pública de ordenación genérica
+ * @brief Prefijo de 8 bytes de una cadena para usar como clave en caché
+ * @param element Puntero a un `const char *` (elemento de create_string_array_iterator)
+ * @return Los 8 primeros bytes en orden big-endian, rellenando con ceros
+ *
+ * Su orden coincide con el de strcmp en los 8 primeros bytes; se usa con
+ * RadixKey{ .key_fn = string_key_prefix, .width = 8, .type = RADIX_KEY_UNSIGNED }.
+ */
+uint64_t string_key_prefix(const void *element)
+{
+    return string_load8(*(const char *const *)element);
+}
+
+/**
+ * @brief Ordena la vista de un GenericArrayIterator con una clave en caché
  * @param it Puntero al iterador a ordenar
- * @param compare Función de comparación para determinar el orden
+ * @param key Clave de cada elemento, normalizada como en generic_radix_sort;
+ *        si la clave de a es menor que la de b, compare(a, b) debe ser negativo
+ * @param compare Función de comparación completa para desempatar claves
+ *        iguales, o NULL si la clave determina el orden por sí sola
+ * @return true si se ordenó, false si la clave no es válida o no hubo memoria
  *
- * Esta función ordena los elementos del iterador usando el algoritmo Introsort.
- * Calcula automáticamente la profundidad máxima de recursión y selecciona el
- * mejor algoritmo para cada caso particular.
+ * La clave se calcula una vez por elemento. Para comparadores caros (cadenas,
+ * registros compuestos) reduce las llamadas a compare a las de los elementos
+ * con la misma clave. Igual que generic_sort, permuta la tabla de punteros.
  */
-void generic_sort(Iterator *it, CompareFunc compare)
+bool generic_sort_cached(Iterator *it, const RadixKey *key, CompareFunc compare)
 {
-    if (!it || !it->impl)
-        return;
+    if (!radix_key_valid(key))
+        return false;
+    if (!it || !it->impl || it->ops != &generic_array_iterator_ops)
+        return false;
+    if (((GenericArrayIterator *)it->impl)->size <= 1)
+        return true;
 
-    GenericArrayIterator *iter = (GenericArrayIterator *)it->impl;
-    if (iter->size <= 1)
-        return;
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return false;
+
+    size_t n = ((GenericArrayIterator *)it->impl)->size;
+    RadixPair *pairs = malloc(n * sizeof(RadixPair));
+    if (!pairs)
+        return false;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        pairs[i].key = radix_normalize(radix_extract(elements[i], key), key);
+        pairs[i].value = (uintptr_t)elements[i];
+    }
 
-    // Calcular la profundidad máxima como 2 * log2(n)
-    int depth_limit = 2 * log2_int(iter->size);
+    CachedSortContext ctx = { .pairs = pairs, .compare = compare };
+    cached_sort(&ctx, 0, n);
 
-    introsort_impl(it, 0, iter->size - 1, depth_limit, compare);
+    for (size_t i = 0; i < n; i++)
+        elements[i] = (void *)pairs[i].value;
+    free(pairs);
 
-    // Resetear el índice después de ordenar
-    iter->index = 0;
-    it->current = iter->elements[0];
+    sort_finish(it);
+    return true;
 }
 
 #endif // CSORTING_C
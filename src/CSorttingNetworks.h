@@ -0,0 +1,247 @@
+/**
+ * @file CSorttingNetworks.h
+ * @brief Redes de ordenación bitónicas AVX2 para las hojas de las ordenaciones por tipo.
+ *
+ * La parte común tiene guardas de inclusión; el resto es una plantilla que se
+ * incluye una vez por tipo desde CSortting.c y define:
+ *
+ *  - static bool network_sort_<SUFIJO>(TIPO *data, size_t count)
+ *
+ * que ordena hasta NETWORK_MAX_ELEMENTS(TIPO) elementos (64 de 32 bits o 32
+ * de 64 bits) en registros y devuelve false si la CPU no tiene AVX2 (o, para
+ * flotantes, si hay algún NaN), para que el llamador use el camino escalar.
+ *
+ * Los elementos se cargan en hasta 8 registros de 256 bits rellenando con un
+ * centinela máximo. Cada registro se ordena con una red bitónica interna y
+ * después los registros se fusionan por parejas: se invierte el segundo
+ * bloque, el mínimo y el máximo elemento a elemento dan dos mitades bitónicas
+ * y cada una se termina con un half-cleaner entre registros y dentro de ellos.
+ *
+ * Parámetros:
+ *  - NETWORK_SUFFIX       Sufijo del nombre (int32, double, ...).
+ *  - NETWORK_T            Tipo de los elementos.
+ *  - NETWORK_SHIFT        0 para elementos de 32 bits, 1 para los de 64 bits.
+ *  - NETWORK_MIN(a, b)    Mínimo elemento a elemento de dos __m256i.
+ *  - NETWORK_MAX(a, b)    Máximo elemento a elemento de dos __m256i.
+ *  - NETWORK_SENTINEL     Valor que va detrás de cualquier elemento.
+ *  - NETWORK_IS_NAN(x)    Opcional: verdadero si x no se puede ordenar con MIN/MAX.
+ */
+
+#ifndef CSORTTING_NETWORKS_H
+#define CSORTTING_NETWORKS_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORT_NETWORKS_AVAILABLE 1
+
+#include <immintrin.h>
+
+#define NETWORK_TARGET __attribute__((target("avx2")))
+#define NETWORK_REGISTERS 8 /**< Registros de 256 bits como máximo por red. */
+#define NETWORK_MAX_ELEMENTS(T) (NETWORK_REGISTERS * 32 / sizeof(T))
+
+/**
+ * @brief Permuta v de modo que la posición p (en palabras de 32 bits) recibe la p ^ x.
+ */
+NETWORK_TARGET static inline __m256i network_permute(__m256i v, int x)
+{
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_permutevar8x32_epi32(v, _mm256_xor_si256(iota, _mm256_set1_epi32(x)));
+}
+
+/**
+ * @brief Máscara de las palabras que se quedan con el mínimo en un paso (j, k) de la red bitónica.
+ *
+ * j es la distancia a la pareja y k el tamaño del bloque que se ordena, ambos
+ * en palabras de 32 bits: toma el mínimo el primero de la pareja en los bloques
+ * ascendentes y el segundo en los descendentes.
+ */
+NETWORK_TARGET static inline __m256i network_min_mask(int j, int k)
+{
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i first = _mm256_cmpeq_epi32(_mm256_and_si256(iota, _mm256_set1_epi32(j)), zero);
+    __m256i ascending = _mm256_cmpeq_epi32(_mm256_and_si256(iota, _mm256_set1_epi32(k)), zero);
+    return _mm256_cmpeq_epi32(first, ascending);
+}
+
+/* Mínimo y máximo para los tipos sin instrucción directa en AVX2 */
+NETWORK_TARGET static inline __m256i network_min_ps(__m256i a, __m256i b)
+{
+    return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+}
+
+NETWORK_TARGET static inline __m256i network_max_ps(__m256i a, __m256i b)
+{
+    return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+}
+
+NETWORK_TARGET static inline __m256i network_min_pd(__m256i a, __m256i b)
+{
+    return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+}
+
+NETWORK_TARGET static inline __m256i network_max_pd(__m256i a, __m256i b)
+{
+    return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+}
+
+NETWORK_TARGET static inline __m256i network_min_epi64(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+NETWORK_TARGET static inline __m256i network_max_epi64(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+/**
+ * @brief true si la CPU ejecuta las redes (se consulta en cada hoja; es una lectura de memoria).
+ */
+static inline bool network_supported(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#define NETWORK_CONCAT_(a, b) a##b
+#define NETWORK_CONCAT(a, b) NETWORK_CONCAT_(a, b)
+
+#endif /* __GNUC__ && x86 */
+#endif /* CSORTTING_NETWORKS_H */
+
+#ifdef SORT_NETWORKS_AVAILABLE
+
+#if !defined(NETWORK_SUFFIX) || !defined(NETWORK_T) || !defined(NETWORK_SHIFT) || \
+    !defined(NETWORK_MIN) || !defined(NETWORK_MAX) || !defined(NETWORK_SENTINEL)
+#error "CSorttingNetworks.h requiere NETWORK_SUFFIX, NETWORK_T, NETWORK_SHIFT, NETWORK_MIN, NETWORK_MAX y NETWORK_SENTINEL"
+#endif
+
+#define NETWORK_NAME(name) NETWORK_CONCAT(NETWORK_CONCAT(network_, name), NETWORK_CONCAT(_, NETWORK_SUFFIX))
+
+/**
+ * @brief Paso (j, k) de la red bitónica dentro de un registro.
+ */
+NETWORK_TARGET static inline __m256i NETWORK_NAME(stage)(__m256i v, int j, int k)
+{
+    __m256i partner = network_permute(v, j);
+    return _mm256_blendv_epi8(NETWORK_MAX(v, partner), NETWORK_MIN(v, partner), network_min_mask(j, k));
+}
+
+/**
+ * @brief Red completa sobre `regs` registros. Se integra en cada caso del
+ *        switch de la función de ordenación para que, con `regs` constante,
+ *        los bucles se desenrollen y los vectores no salgan de los registros.
+ */
+NETWORK_TARGET static inline __attribute__((always_inline))
+void NETWORK_NAME(run)(__m256i *v, size_t regs)
+{
+    enum { LANES = 8 >> NETWORK_SHIFT };
+    const int reverse = (LANES - 1) << NETWORK_SHIFT;
+    const int ascending = LANES << NETWORK_SHIFT;
+
+    // Cada registro por separado
+    for (size_t r = 0; r < regs; r++)
+        for (int k = 2; k <= LANES; k <<= 1)
+            for (int j = k >> 1; j > 0; j >>= 1)
+                v[r] = NETWORK_NAME(stage)(v[r], j << NETWORK_SHIFT, k << NETWORK_SHIFT);
+
+    // Fusión de bloques ordenados de w registros
+    for (size_t w = 1; w < regs; w <<= 1)
+    {
+        for (size_t g = 0; g < regs; g += 2 * w)
+        {
+            __m256i hi[NETWORK_REGISTERS / 2];
+            for (size_t t = 0; t < w; t++)
+            {
+                __m256i a = v[g + t];
+                __m256i b = network_permute(v[g + 2 * w - 1 - t], reverse);
+                v[g + t] = NETWORK_MIN(a, b);
+                hi[t] = NETWORK_MAX(a, b);
+            }
+            for (size_t t = 0; t < w; t++)
+                v[g + w + t] = hi[t];
+
+            // Las dos mitades son bitónicas: half-cleaners entre registros y dentro de cada uno
+            for (size_t h = g; h < g + 2 * w; h += w)
+            {
+                for (size_t d = w >> 1; d > 0; d >>= 1)
+                    for (size_t x = h; x < h + w; x++)
+                        if (((x - h) & d) == 0)
+                        {
+                            __m256i a = v[x];
+                            v[x] = NETWORK_MIN(a, v[x + d]);
+                            v[x + d] = NETWORK_MAX(a, v[x + d]);
+                        }
+                for (size_t x = h; x < h + w; x++)
+                    for (int j = LANES >> 1; j > 0; j >>= 1)
+                        v[x] = NETWORK_NAME(stage)(v[x], j << NETWORK_SHIFT, ascending);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ordena data[0, count) con la red bitónica.
+ * @return false si no se puede usar la red (la hoja se ordena con el camino escalar).
+ */
+NETWORK_TARGET static bool NETWORK_NAME(sort)(NETWORK_T *data, size_t count)
+{
+    enum { LANES = 8 >> NETWORK_SHIFT, MAX_ELEMENTS = NETWORK_MAX_ELEMENTS(NETWORK_T) };
+
+    if (count > MAX_ELEMENTS || !network_supported())
+        return false;
+
+    NETWORK_T buffer[MAX_ELEMENTS] __attribute__((aligned(32)));
+    size_t regs = 1;
+    while (regs * LANES < count)
+        regs <<= 1;
+
+    for (size_t i = 0; i < count; i++)
+    {
+#ifdef NETWORK_IS_NAN
+        if (NETWORK_IS_NAN(data[i]))
+            return false;
+#endif
+        buffer[i] = data[i];
+    }
+    for (size_t i = count; i < regs * LANES; i++)
+        buffer[i] = NETWORK_SENTINEL;
+
+    __m256i v[NETWORK_REGISTERS];
+    for (size_t r = 0; r < regs; r++)
+        v[r] = _mm256_load_si256((const __m256i *)buffer + r);
+
+    switch (regs)
+    {
+    case 1:
+        NETWORK_NAME(run)(v, 1);
+        break;
+    case 2:
+        NETWORK_NAME(run)(v, 2);
+        break;
+    case 4:
+        NETWORK_NAME(run)(v, 4);
+        break;
+    default:
+        NETWORK_NAME(run)(v, NETWORK_REGISTERS);
+        break;
+    }
+
+    for (size_t r = 0; r < regs; r++)
+        _mm256_store_si256((__m256i *)buffer + r, v[r]);
+    for (size_t i = 0; i < count; i++)
+        data[i] = buffer[i];
+    return true;
+}
+
+#undef NETWORK_NAME
+
+#endif /* SORT_NETWORKS_AVAILABLE */
+
+#undef NETWORK_SUFFIX
+#undef NETWORK_T
+#undef NETWORK_SHIFT
+#undef NETWORK_MIN
+#undef NETWORK_MAX
+#undef NETWORK_SENTINEL
+#undef NETWORK_IS_NAN
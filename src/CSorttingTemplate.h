@@ -0,0 +1,705 @@
+/**
+ * @file CSorttingTemplate.h
+ * @brief Plantilla del motor de ordenación (pattern-defeating quicksort).
+ *
+ * Este archivo NO tiene guardas de inclusión: se incluye una vez por cada
+ * variante del motor, tras definir los parámetros de la plantilla. El motor
+ * trabaja sobre índices en [begin, end) y solo necesita dos operaciones sobre
+ * los elementos, lo que permite instanciarlo igual para tablas de punteros,
+ * registros de tamaño arbitrario o tipos primitivos:
+ *
+ *  - SORT_NAME(name)        Prefijo de las funciones generadas.
+ *  - SORT_CTX               Tipo del contexto que se pasa a todas las funciones.
+ *  - SORT_LESS(ctx, i, j)   Verdadero si el elemento i va antes que el j.
+ *  - SORT_SWAP(ctx, i, j)   Intercambia los elementos i y j.
+ *
+ * El pivote se mantiene en su posición (begin) durante la partición, de modo
+ * que no hace falta ningún almacenamiento temporal para los elementos. Los
+ * argumentos de SORT_LESS y SORT_SWAP nunca tienen efectos secundarios, así
+ * que las macros pueden evaluarlos más de una vez.
+ *
+ * Parámetros opcionales: si los elementos se pueden copiar a una variable
+ * local, las ordenaciones por inserción desplazan en lugar de intercambiar
+ * (una escritura por posición en vez de dos lecturas y dos escrituras):
+ *
+ *  - SORT_VALUE_T                 Tipo de la copia local de un elemento.
+ *  - SORT_GET(ctx, i)             Lee el elemento i como SORT_VALUE_T.
+ *  - SORT_SET(ctx, i, v)          Escribe el valor v en la posición i.
+ *  - SORT_VALUE_LESS(ctx, v, i)   Verdadero si el valor v va antes que el elemento i.
+ *
+ * Las hojas de la recursión pueden delegarse en una ordenación especializada
+ * (redes de ordenación SIMD, por ejemplo):
+ *
+ *  - SORT_SMALL_SORT(ctx, begin, end)  Ordena [begin, end) por completo y
+ *                                      devuelve true, o devuelve false si no
+ *                                      puede (la hoja sigue el camino normal).
+ *  - SORT_SMALL_SORT_MAX               Tamaño máximo que acepta SORT_SMALL_SORT.
+ *
+ * Si se define SORT_BLOCK_PARTITION, la partición principal es la de bloques
+ * (BlockQuicksort): los resultados de las comparaciones se acumulan en
+ * arrays de desplazamientos sin saltos condicionales y después se hacen los
+ * intercambios. Conviene cuando SORT_LESS no predice bien (datos aleatorios).
+ *
+ * Requiere que log2_int() esté definida antes de incluir este archivo.
+ */
+
+#if !defined(SORT_NAME) || !defined(SORT_CTX) || !defined(SORT_LESS) || !defined(SORT_SWAP)
+#error "CSorttingTemplate.h requiere SORT_NAME, SORT_CTX, SORT_LESS y SORT_SWAP"
+#endif
+
+#ifndef SORT_INSERTION_THRESHOLD
+#define SORT_INSERTION_THRESHOLD 24   /**< Por debajo de este tamaño se usa insertion sort. */
+#endif
+#ifndef SORT_NINTHER_THRESHOLD
+#define SORT_NINTHER_THRESHOLD 128    /**< A partir de este tamaño el pivote es la mediana de 9 (ninther). */
+#endif
+#ifndef SORT_BLOCK_SIZE
+#define SORT_BLOCK_SIZE 64            /**< Elementos por bloque de la partición por bloques (cabe en un unsigned char). */
+#endif
+#ifndef SORT_PARTIAL_INSERTION_LIMIT
+#define SORT_PARTIAL_INSERTION_LIMIT 8 /**< Desplazamientos máximos antes de abandonar partial_insertion_sort. */
+#endif
+
+#ifdef SORT_VALUE_T
+/**
+ * @brief Inserta el elemento i en el tramo ordenado que le precede, desplazando.
+ *
+ * @param guard Límite inferior del desplazamiento; con `unguarded` se ignora
+ *              porque hay un elemento menor o igual antes del tramo.
+ * @return Número de posiciones desplazadas.
+ */
+static inline size_t SORT_NAME(insert_one)(const SORT_CTX *ctx, size_t guard, size_t i, bool unguarded)
+{
+    if (!SORT_LESS(ctx, i, i - 1))
+        return 0;
+
+    SORT_VALUE_T tmp = SORT_GET(ctx, i);
+    size_t j = i;
+    do
+    {
+        SORT_SET(ctx, j, SORT_GET(ctx, j - 1));
+        j--;
+    } while ((unguarded || j > guard) && SORT_VALUE_LESS(ctx, tmp, j - 1));
+    SORT_SET(ctx, j, tmp);
+    return i - j;
+}
+#else
+static inline size_t SORT_NAME(insert_one)(const SORT_CTX *ctx, size_t guard, size_t i, bool unguarded)
+{
+    size_t j = i;
+    while ((unguarded || j > guard) && SORT_LESS(ctx, j, j - 1))
+    {
+        SORT_SWAP(ctx, j, j - 1);
+        j--;
+    }
+    return i - j;
+}
+#endif
+
+/**
+ * @brief Ordenación por inserción del subrango [begin, end).
+ */
+static void SORT_NAME(insertion_sort)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    if (end - begin < 2)
+        return;
+
+    for (size_t i = begin + 1; i < end; i++)
+        SORT_NAME(insert_one)(ctx, begin, i, false);
+}
+
+/**
+ * @brief Ordenación por inserción sin comprobación de límite inferior.
+ *
+ * Solo es válida si el elemento en begin - 1 no es mayor que ninguno de
+ * [begin, end), lo que se cumple para toda partición que no sea la más a la izquierda.
+ */
+static void SORT_NAME(unguarded_insertion_sort)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    for (size_t i = begin + 1; i < end; i++)
+        SORT_NAME(insert_one)(ctx, begin, i, true);
+}
+
+/**
+ * @brief Intenta ordenar [begin, end) por inserción con un límite de desplazamientos.
+ * @return true si el subrango quedó ordenado, false si se superó el límite.
+ */
+static bool SORT_NAME(partial_insertion_sort)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    size_t moves = 0;
+
+    for (size_t i = begin + 1; i < end; i++)
+    {
+        moves += SORT_NAME(insert_one)(ctx, begin, i, false);
+        if (moves > SORT_PARTIAL_INSERTION_LIMIT)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Hunde el nodo `root` de un heap máximo que empieza en `base` y tiene n nodos.
+ */
+static void SORT_NAME(sift_down)(const SORT_CTX *ctx, size_t base, size_t root, size_t n)
+{
+    size_t child;
+    while ((child = 2 * root + 1) < n)
+    {
+        if (child + 1 < n && SORT_LESS(ctx, base + child, base + child + 1))
+            child++;
+        if (!SORT_LESS(ctx, base + root, base + child))
+            return;
+        SORT_SWAP(ctx, base + root, base + child);
+        root = child;
+    }
+}
+
+/**
+ * @brief HeapSort sobre el subrango [begin, end).
+ *
+ * Se usa cuando demasiadas particiones salen desequilibradas, para garantizar
+ * O(n log n) en el peor caso.
+ */
+static void SORT_NAME(heap_sort)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    size_t n = end - begin;
+    if (n < 2)
+        return;
+
+    for (size_t i = n / 2; i-- > 0;)
+        SORT_NAME(sift_down)(ctx, begin, i, n);
+
+    for (size_t i = n - 1; i > 0; i--)
+    {
+        SORT_SWAP(ctx, begin, begin + i);
+        SORT_NAME(sift_down)(ctx, begin, 0, i);
+    }
+}
+
+/**
+ * @brief Ordena los elementos a, b y c entre sí (red de 3 comparaciones).
+ */
+static void SORT_NAME(sort3)(const SORT_CTX *ctx, size_t a, size_t b, size_t c)
+{
+    if (SORT_LESS(ctx, b, a))
+        SORT_SWAP(ctx, a, b);
+    if (SORT_LESS(ctx, c, b))
+        SORT_SWAP(ctx, b, c);
+    if (SORT_LESS(ctx, b, a))
+        SORT_SWAP(ctx, a, b);
+}
+
+/**
+ * @brief Elige el pivote de [begin, end) y lo deja en begin.
+ *
+ * Mediana de 3 para rangos pequeños y ninther (mediana de tres medianas) para
+ * rangos grandes. En ambos casos queda a la derecha del pivote al menos un
+ * elemento mayor o igual, que sirve de centinela a la partición.
+ */
+static void SORT_NAME(choose_pivot)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    size_t size = end - begin;
+    size_t s2 = size / 2;
+
+    if (size > SORT_NINTHER_THRESHOLD)
+    {
+        SORT_NAME(sort3)(ctx, begin, begin + s2, end - 1);
+        SORT_NAME(sort3)(ctx, begin + 1, begin + (s2 - 1), end - 2);
+        SORT_NAME(sort3)(ctx, begin + 2, begin + (s2 + 1), end - 3);
+        SORT_NAME(sort3)(ctx, begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+        SORT_SWAP(ctx, begin, begin + s2);
+    }
+    else
+    {
+        SORT_NAME(sort3)(ctx, begin + s2, begin, end - 1);
+    }
+}
+
+/**
+ * @brief Partición de Hoare con el pivote en begin; los iguales al pivote van a la derecha.
+ *
+ * @param already_partitioned Se pone a true si no hubo que intercambiar nada.
+ * @return Posición final del pivote.
+ */
+static inline size_t SORT_NAME(partition_right)(const SORT_CTX *ctx, size_t begin, size_t end,
+                                                bool *already_partitioned)
+{
+    size_t first = begin;
+    size_t last = end;
+
+    // Primer elemento >= pivote (existe gracias a choose_pivot)
+    do { first++; } while (SORT_LESS(ctx, first, begin));
+
+    // Último elemento < pivote; si no hay ninguno a la izquierda hay que acotar
+    if (first - 1 == begin)
+    {
+        while (first < last)
+        {
+            last--;
+            if (SORT_LESS(ctx, last, begin))
+                break;
+        }
+    }
+    else
+    {
+        do { last--; } while (!SORT_LESS(ctx, last, begin));
+    }
+
+    *already_partitioned = first >= last;
+
+    while (first < last)
+    {
+        SORT_SWAP(ctx, first, last);
+        do { first++; } while (SORT_LESS(ctx, first, begin));
+        do { last--; } while (!SORT_LESS(ctx, last, begin));
+    }
+
+    size_t pivot_pos = first - 1;
+    SORT_SWAP(ctx, begin, pivot_pos);
+    return pivot_pos;
+}
+
+/**
+ * @brief Partición por bloques de [first, last) respecto al elemento `pivot` (fuera del rango).
+ *
+ * Con `equal_left` a la izquierda van los elementos no mayores que el pivote
+ * (en un rango sin menores, los iguales); si no, los menores. Por cada bloque
+ * de SORT_BLOCK_SIZE elementos del extremo izquierdo se apunta el
+ * desplazamiento de los que están en el lado equivocado (se escribe siempre y
+ * solo avanza el contador), y lo mismo en el extremo derecho. Después se
+ * intercambian por parejas tantos como haya en el bloque más corto; el bloque
+ * que no se agota se conserva para la siguiente vuelta. Así el único salto
+ * mal predicho por bloque es el final del bucle (BlockQuicksort).
+ *
+ * @return Primera posición de la parte derecha.
+ */
+static inline size_t SORT_NAME(block_partition)(const SORT_CTX *ctx, size_t pivot, size_t first, size_t last,
+                                                bool equal_left)
+{
+#define SORT_GOES_LEFT(x) (equal_left ? !SORT_LESS(ctx, pivot, (x)) : SORT_LESS(ctx, (x), pivot))
+    unsigned char offsets_l[SORT_BLOCK_SIZE];
+    unsigned char offsets_r[SORT_BLOCK_SIZE];
+    size_t l_base = first, r_base = last;
+    size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (first < last)
+    {
+        // Reparto de los elementos sin clasificar entre los bloques vacíos
+        size_t unknown = last - first;
+        size_t left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+        size_t right_split = num_r == 0 ? unknown - left_split : 0;
+
+        if (left_split > SORT_BLOCK_SIZE)
+            left_split = SORT_BLOCK_SIZE;
+        for (size_t i = 0; i < left_split; i++)
+        {
+            offsets_l[num_l] = (unsigned char)i;
+            num_l += !SORT_GOES_LEFT(first);
+            first++;
+        }
+
+        if (right_split > SORT_BLOCK_SIZE)
+            right_split = SORT_BLOCK_SIZE;
+        for (size_t i = 1; i <= right_split; i++)
+        {
+            last--;
+            offsets_r[num_r] = (unsigned char)i;
+            num_r += SORT_GOES_LEFT(last);
+        }
+
+        size_t num = num_l < num_r ? num_l : num_r;
+        for (size_t i = 0; i < num; i++)
+            SORT_SWAP(ctx, l_base + offsets_l[start_l + i], r_base - offsets_r[start_r + i]);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+
+        if (num_l == 0)
+        {
+            start_l = 0;
+            l_base = first;
+        }
+        if (num_r == 0)
+        {
+            start_r = 0;
+            r_base = last;
+        }
+    }
+#undef SORT_GOES_LEFT
+
+    // Lo que queda en un bloque va al extremo contrario de la zona ya clasificada
+    if (num_l)
+    {
+        while (num_l--)
+        {
+            last--;
+            SORT_SWAP(ctx, l_base + offsets_l[start_l + num_l], last);
+        }
+        first = last;
+    }
+    if (num_r)
+    {
+        while (num_r--)
+        {
+            SORT_SWAP(ctx, r_base - offsets_r[start_r + num_r], first);
+            first++;
+        }
+    }
+    return first;
+}
+
+#ifdef SORT_BLOCK_PARTITION
+/**
+ * @brief Igual que partition_right, pero el grueso de la partición se hace
+ *        por bloques sin saltos que dependan de las comparaciones.
+ */
+static size_t SORT_NAME(partition_right_block)(const SORT_CTX *ctx, size_t begin, size_t end,
+                                               bool *already_partitioned)
+{
+    size_t first = begin;
+    size_t last = end;
+
+    do { first++; } while (SORT_LESS(ctx, first, begin));
+
+    if (first - 1 == begin)
+    {
+        while (first < last)
+        {
+            last--;
+            if (SORT_LESS(ctx, last, begin))
+                break;
+        }
+    }
+    else
+    {
+        do { last--; } while (!SORT_LESS(ctx, last, begin));
+    }
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned)
+    {
+        SORT_SWAP(ctx, first, last);
+        first = SORT_NAME(block_partition)(ctx, begin, first + 1, last, false);
+    }
+
+    size_t pivot_pos = first - 1;
+    SORT_SWAP(ctx, begin, pivot_pos);
+    return pivot_pos;
+}
+#endif
+
+/**
+ * @brief Partición principal del motor: por bloques si se definió SORT_BLOCK_PARTITION.
+ */
+static inline size_t SORT_NAME(partition)(const SORT_CTX *ctx, size_t begin, size_t end,
+                                          bool *already_partitioned)
+{
+#ifdef SORT_BLOCK_PARTITION
+    return SORT_NAME(partition_right_block)(ctx, begin, end, already_partitioned);
+#else
+    return SORT_NAME(partition_right)(ctx, begin, end, already_partitioned);
+#endif
+}
+
+/**
+ * @brief Partición con el pivote en begin; los iguales al pivote van a la izquierda.
+ *
+ * Se usa cuando el pivote es igual al elemento anterior al rango: todos los
+ * elementos que acaban a la izquierda son iguales al pivote y ya no hace falta
+ * ordenarlos, lo que hace lineal el caso de muchas claves repetidas.
+ *
+ * @return Posición final del pivote.
+ */
+static size_t SORT_NAME(partition_left)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    size_t first = begin;
+    size_t last = end;
+
+    do { last--; } while (SORT_LESS(ctx, begin, last));
+
+    if (last + 1 == end)
+    {
+        while (first < last)
+        {
+            first++;
+            if (SORT_LESS(ctx, begin, first))
+                break;
+        }
+    }
+    else
+    {
+        do { first++; } while (!SORT_LESS(ctx, begin, first));
+    }
+
+    while (first < last)
+    {
+        SORT_SWAP(ctx, first, last);
+        do { last--; } while (SORT_LESS(ctx, begin, last));
+        do { first++; } while (!SORT_LESS(ctx, begin, first));
+    }
+
+    SORT_SWAP(ctx, begin, last);
+    return last;
+}
+
+/**
+ * @brief Desordena unos pocos elementos de una partición desequilibrada para
+ *        romper patrones que provocan malos pivotes.
+ */
+static void SORT_NAME(break_patterns)(const SORT_CTX *ctx, size_t begin, size_t pivot_pos, size_t end)
+{
+    size_t l_size = pivot_pos - begin;
+    size_t r_size = end - (pivot_pos + 1);
+
+    if (l_size >= SORT_INSERTION_THRESHOLD)
+    {
+        SORT_SWAP(ctx, begin, begin + l_size / 4);
+        SORT_SWAP(ctx, pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > SORT_NINTHER_THRESHOLD)
+        {
+            SORT_SWAP(ctx, begin + 1, begin + (l_size / 4 + 1));
+            SORT_SWAP(ctx, begin + 2, begin + (l_size / 4 + 2));
+            SORT_SWAP(ctx, pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            SORT_SWAP(ctx, pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+    }
+
+    if (r_size >= SORT_INSERTION_THRESHOLD)
+    {
+        SORT_SWAP(ctx, pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        SORT_SWAP(ctx, end - 1, end - r_size / 4);
+        if (r_size > SORT_NINTHER_THRESHOLD)
+        {
+            SORT_SWAP(ctx, pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            SORT_SWAP(ctx, pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            SORT_SWAP(ctx, end - 2, end - (1 + r_size / 4));
+            SORT_SWAP(ctx, end - 3, end - (2 + r_size / 4));
+        }
+    }
+}
+
+/**
+ * @brief Bucle principal de pdqsort sobre [begin, end).
+ *
+ * @param bad_allowed Particiones desequilibradas toleradas antes de pasar a HeapSort.
+ * @param leftmost true si no hay ningún elemento del array a la izquierda de begin.
+ *
+ * Solo se recurre sobre la mitad más pequeña y se itera sobre la grande, por lo
+ * que la profundidad de pila está acotada por log2(n).
+ */
+static void SORT_NAME(pdqsort_loop)(const SORT_CTX *ctx, size_t begin, size_t end,
+                                    int bad_allowed, bool leftmost)
+{
+    for (;;)
+    {
+        size_t size = end - begin;
+
+#ifdef SORT_SMALL_SORT
+        if (size <= SORT_SMALL_SORT_MAX && SORT_SMALL_SORT(ctx, begin, end))
+            return;
+#endif
+
+        if (size < SORT_INSERTION_THRESHOLD)
+        {
+            if (leftmost)
+                SORT_NAME(insertion_sort)(ctx, begin, end);
+            else
+                SORT_NAME(unguarded_insertion_sort)(ctx, begin, end);
+            return;
+        }
+
+        SORT_NAME(choose_pivot)(ctx, begin, end);
+
+        // Si el pivote es igual al elemento anterior, toda esta partición es >= pivote:
+        // se apartan los iguales de una vez y se sigue solo con los mayores.
+        if (!leftmost && !SORT_LESS(ctx, begin - 1, begin))
+        {
+            begin = SORT_NAME(partition_left)(ctx, begin, end) + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        size_t pivot_pos = SORT_NAME(partition)(ctx, begin, end, &already_partitioned);
+
+        size_t l_size = pivot_pos - begin;
+        size_t r_size = end - (pivot_pos + 1);
+        bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced)
+        {
+            if (--bad_allowed == 0)
+            {
+                SORT_NAME(heap_sort)(ctx, begin, end);
+                return;
+            }
+            SORT_NAME(break_patterns)(ctx, begin, pivot_pos, end);
+        }
+        else if (already_partitioned &&
+                 SORT_NAME(partial_insertion_sort)(ctx, begin, pivot_pos) &&
+                 SORT_NAME(partial_insertion_sort)(ctx, pivot_pos + 1, end))
+        {
+            // Entrada (casi) ordenada: terminado en tiempo lineal
+            return;
+        }
+
+        // Recursión sobre la mitad pequeña, iteración sobre la grande
+        if (l_size < r_size)
+        {
+            SORT_NAME(pdqsort_loop)(ctx, begin, pivot_pos, bad_allowed, leftmost);
+            begin = pivot_pos + 1;
+            leftmost = false;
+        }
+        else
+        {
+            SORT_NAME(pdqsort_loop)(ctx, pivot_pos + 1, end, bad_allowed, false);
+            end = pivot_pos;
+        }
+    }
+}
+
+static inline void SORT_NAME(select)(const SORT_CTX *ctx, size_t begin, size_t nth, size_t end);
+
+/**
+ * @brief Deja en begin la mediana de las medianas de los grupos de 5 de [begin, end).
+ *
+ * Garantiza que al menos un 30% de los elementos quedan a cada lado del
+ * pivote. Requiere end - begin >= SORT_INSERTION_THRESHOLD.
+ */
+static inline void SORT_NAME(median_of_medians)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    size_t groups = (end - begin) / 5;
+
+    for (size_t g = 0; g < groups; g++)
+    {
+        size_t first = begin + 5 * g;
+        SORT_NAME(insertion_sort)(ctx, first, first + 5);
+        SORT_SWAP(ctx, begin + g, first + 2);
+    }
+
+    SORT_NAME(select)(ctx, begin, begin + groups / 2, begin + groups);
+    SORT_SWAP(ctx, begin, begin + groups / 2);
+}
+
+/**
+ * @brief Introselect: deja en nth el elemento que ocuparía esa posición si
+ *        [begin, end) estuviera ordenado, con los menores o iguales delante y
+ *        los mayores o iguales detrás.
+ *
+ * Quickselect con los pivotes de pdqsort; si las particiones se desequilibran
+ * demasiado pasa a la mediana de las medianas, que garantiza tiempo lineal.
+ */
+static inline void SORT_NAME(select)(const SORT_CTX *ctx, size_t begin, size_t nth, size_t end)
+{
+    int bad_allowed = log2_int(end - begin) + 1;
+
+    while (end - begin > SORT_INSERTION_THRESHOLD)
+    {
+        size_t size = end - begin;
+
+        if (bad_allowed > 0)
+            SORT_NAME(choose_pivot)(ctx, begin, end);
+        else
+            SORT_NAME(median_of_medians)(ctx, begin, end);
+
+        bool already_partitioned;
+        size_t pivot_pos = SORT_NAME(partition)(ctx, begin, end, &already_partitioned);
+        size_t l_size = pivot_pos - begin;
+        size_t r_size = end - (pivot_pos + 1);
+        if (l_size < size / 8 || r_size < size / 8)
+            bad_allowed--;
+
+        if (nth == pivot_pos)
+            return;
+        if (nth < pivot_pos)
+        {
+            end = pivot_pos;
+        }
+        else if (l_size < size / 8)
+        {
+            // Puede que la derecha esté llena de iguales al pivote: se apartan de una vez
+            size_t equal_end = SORT_NAME(partition_left)(ctx, pivot_pos, end);
+            if (nth <= equal_end)
+                return;
+            begin = equal_end + 1;
+        }
+        else
+        {
+            begin = pivot_pos + 1;
+        }
+    }
+
+    SORT_NAME(insertion_sort)(ctx, begin, end);
+}
+
+/**
+ * @brief Quicksort con partición a tres vías sobre [begin, end).
+ *
+ * Cada partición separa menores, iguales y mayores que el pivote con dos
+ * pasadas de block_partition (la segunda solo sobre los no menores) y deja
+ * los iguales en su posición final,
+ * así que con k claves distintas el coste es O(n log k). Como en
+ * pdqsort_loop, se recurre sobre la parte pequeña, se itera sobre la grande y
+ * tras `bad_allowed` particiones muy desequilibradas se pasa a HeapSort.
+ */
+static inline void SORT_NAME(three_way_sort)(const SORT_CTX *ctx, size_t begin, size_t end, int bad_allowed)
+{
+    for (;;)
+    {
+        size_t size = end - begin;
+        if (size < SORT_INSERTION_THRESHOLD)
+        {
+            SORT_NAME(insertion_sort)(ctx, begin, end);
+            return;
+        }
+
+        SORT_NAME(choose_pivot)(ctx, begin, end);
+
+        // Dos pasadas por bloques: [begin, lt) < pivote y, del resto, [lt, gt) == pivote, [gt, end) > pivote
+        size_t lt = SORT_NAME(block_partition)(ctx, begin, begin + 1, end, false) - 1;
+        SORT_SWAP(ctx, begin, lt);
+        size_t gt = SORT_NAME(block_partition)(ctx, lt, lt + 1, end, true);
+
+        size_t l_size = lt - begin;
+        size_t r_size = end - gt;
+        if ((l_size > size - size / 8 || r_size > size - size / 8) && --bad_allowed <= 0)
+        {
+            SORT_NAME(heap_sort)(ctx, begin, lt);
+            SORT_NAME(heap_sort)(ctx, gt, end);
+            return;
+        }
+
+        if (l_size < r_size)
+        {
+            SORT_NAME(three_way_sort)(ctx, begin, lt, bad_allowed);
+            begin = gt;
+        }
+        else
+        {
+            SORT_NAME(three_way_sort)(ctx, gt, end, bad_allowed);
+            end = lt;
+        }
+    }
+}
+
+/**
+ * @brief Ordena el subrango [begin, end) con pdqsort.
+ */
+static void SORT_NAME(sort)(const SORT_CTX *ctx, size_t begin, size_t end)
+{
+    if (end - begin < 2)
+        return;
+    SORT_NAME(pdqsort_loop)(ctx, begin, end, log2_int(end - begin) + 1, true);
+}
+
+#undef SORT_NAME
+#undef SORT_CTX
+#undef SORT_LESS
+#undef SORT_SWAP
+#undef SORT_VALUE_T
+#undef SORT_GET
+#undef SORT_SET
+#undef SORT_VALUE_LESS
+#undef SORT_SMALL_SORT
+#undef SORT_SMALL_SORT_MAX
+#undef SORT_BLOCK_PARTITION
@@ -0,0 +1,100 @@
+/**
+ * @file CSorttingTyped.h
+ * @brief Plantilla de las ordenaciones especializadas por tipo primitivo.
+ *
+ * Sin guardas de inclusión: se incluye una vez por tipo desde CSortting.c.
+ * Instancia el motor de CSorttingTemplate.h dos veces (sobre el array del
+ * tipo y sobre la tabla de punteros de un GenericArrayIterator) con la
+ * comparación escrita en línea, y define las dos funciones públicas:
+ *
+ *  - generic_sort_<SUFIJO>(Iterator *it)
+ *  - generic_sort_<SUFIJO>_array(TIPO *array, size_t count)
+ *
+ * Parámetros:
+ *  - TYPED_SUFFIX       Sufijo de los nombres (int32, double, str, ...).
+ *  - TYPED_T            Tipo de los elementos.
+ *  - TYPED_LESS(a, b)   Verdadero si el valor a va antes que el valor b.
+ *
+ * Opcionales, para las hojas del motor sobre el array:
+ *  - TYPED_SMALL_SORT(data, count)  Ordena un bloque pequeño o devuelve false.
+ *  - TYPED_SMALL_SORT_MAX           Tamaño máximo que acepta TYPED_SMALL_SORT.
+ */
+
+#if !defined(TYPED_SUFFIX) || !defined(TYPED_T) || !defined(TYPED_LESS)
+#error "CSorttingTyped.h requiere TYPED_SUFFIX, TYPED_T y TYPED_LESS"
+#endif
+
+#define TYPED_CONCAT_(a, b) a##b
+#define TYPED_CONCAT(a, b) TYPED_CONCAT_(a, b)
+#define TYPED_NAME(prefix, name) TYPED_CONCAT(TYPED_CONCAT(prefix, TYPED_SUFFIX), name)
+
+/* Motor sobre el array del tipo: los elementos se mueven directamente */
+#define SORT_NAME(name) TYPED_NAME(typed_array_, TYPED_CONCAT(_, name))
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX TypedSortContext
+#define SORT_LESS(ctx, i, j) TYPED_LESS(((TYPED_T *)(ctx)->data)[i], ((TYPED_T *)(ctx)->data)[j])
+#define SORT_SWAP(ctx, i, j)                  \
+    do {                                      \
+        TYPED_T *d_ = (TYPED_T *)(ctx)->data; \
+        TYPED_T t_ = d_[i];                   \
+        d_[i] = d_[j];                        \
+        d_[j] = t_;                           \
+    } while (0)
+#define SORT_VALUE_T TYPED_T
+#define SORT_GET(ctx, i) (((TYPED_T *)(ctx)->data)[i])
+#define SORT_SET(ctx, i, v) (((TYPED_T *)(ctx)->data)[i] = (v))
+#define SORT_VALUE_LESS(ctx, v, i) TYPED_LESS((v), ((TYPED_T *)(ctx)->data)[i])
+#ifdef TYPED_SMALL_SORT
+#define SORT_SMALL_SORT(ctx, begin, end) TYPED_SMALL_SORT((TYPED_T *)(ctx)->data + (begin), (end) - (begin))
+#define SORT_SMALL_SORT_MAX TYPED_SMALL_SORT_MAX
+#endif
+#include "CSorttingTemplate.h"
+
+/* Motor sobre la tabla de punteros de un GenericArrayIterator */
+#define SORT_NAME(name) TYPED_NAME(typed_table_, TYPED_CONCAT(_, name))
+#define SORT_BLOCK_PARTITION
+#define SORT_CTX TypedSortContext
+#define SORT_LESS(ctx, i, j) \
+    TYPED_LESS(*(const TYPED_T *)((void **)(ctx)->data)[i], *(const TYPED_T *)((void **)(ctx)->data)[j])
+#define SORT_SWAP(ctx, i, j)                \
+    do {                                    \
+        void **d_ = (void **)(ctx)->data;   \
+        void *t_ = d_[i];                   \
+        d_[i] = d_[j];                      \
+        d_[j] = t_;                         \
+    } while (0)
+#define SORT_VALUE_T void *
+#define SORT_GET(ctx, i) (((void **)(ctx)->data)[i])
+#define SORT_SET(ctx, i, v) (((void **)(ctx)->data)[i] = (v))
+#define SORT_VALUE_LESS(ctx, v, i) TYPED_LESS(*(const TYPED_T *)(v), *(const TYPED_T *)((void **)(ctx)->data)[i])
+#include "CSorttingTemplate.h"
+
+void TYPED_NAME(generic_sort_, )(Iterator *it)
+{
+    void **elements = sort_prepare_table(it);
+    if (!elements)
+        return;
+
+    TypedSortContext ctx = { .data = elements };
+    TYPED_NAME(typed_table_, _sort)(&ctx, 0, ((GenericArrayIterator *)it->impl)->size);
+
+    sort_finish(it);
+}
+
+void TYPED_NAME(generic_sort_, _array)(TYPED_T *array, size_t count)
+{
+    if (!array || count <= 1)
+        return;
+
+    TypedSortContext ctx = { .data = array };
+    TYPED_NAME(typed_array_, _sort)(&ctx, 0, count);
+}
+
+#undef TYPED_NAME
+#undef TYPED_CONCAT
+#undef TYPED_CONCAT_
+#undef TYPED_SUFFIX
+#undef TYPED_T
+#undef TYPED_LESS
+#undef TYPED_SMALL_SORT
+#undef TYPED_SMALL_SORT_MAX